@@ -0,0 +1,66 @@
+/**
+ * @brief CCSDS header encode/decode micro-benchmark.
+ *
+ * Measures the cost of building a Primary + Secondary header with
+ * CCSDS_WrapTelemetry and of decoding APID + MET back out of it, with the
+ * packet placed at an odd (unaligned) offset exactly as it sits in a frame.
+ *
+ * Host: built by the host CMake build (target bench_ccsds_header, or run
+ * every benchmark with `cmake --build build --target bench`).
+ *
+ * Target: call BENCH_CCSDS_Header() from app_main(); timing uses esp_timer.
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include "ccsds_packet.h"
+#include "byte_order.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_timer.h"
+static uint64_t bench_now_ns(void) { return (uint64_t)esp_timer_get_time() * 1000ULL; }
+#define BENCH_ITERATIONS 100000UL
+#else
+#include <time.h>
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+#define BENCH_ITERATIONS 10000000UL
+#endif
+
+// volatile sink so the optimiser cannot drop the decode loop
+static volatile uint64_t bench_sink;
+
+void BENCH_CCSDS_Header(void) {
+    static uint8_t raw[CCSDS_HEADERS_SIZE + 8];
+    uint8_t* pkt = &raw[1];   // Deliberately unaligned
+    const uint8_t app_data[1] = {0x5A};
+
+    // 1. Encode: full header build (1 byte of app data)
+    uint64_t start = bench_now_ns();
+    for (unsigned long i = 0; i < BENCH_ITERATIONS; i++) {
+        CCSDS_WrapTelemetry((uint16_t)(i & 0x07FF), app_data, 1, pkt);
+    }
+    uint64_t encode_ns = bench_now_ns() - start;
+
+    // 2. Decode: APID + MET, the fields the ground station reads
+    uint64_t acc = 0;
+    start = bench_now_ns();
+    for (unsigned long i = 0; i < BENCH_ITERATIONS; i++) {
+        pkt[1] = (uint8_t)i;
+        acc += CCSDS_GetAPID(pkt) + BE_Load64(pkt + CCSDS_MET_OFFSET);
+    }
+    uint64_t decode_ns = bench_now_ns() - start;
+    bench_sink = acc;
+
+    printf("BENCH ccsds_header_encode: %.2f ns/op\n", (double)encode_ns / BENCH_ITERATIONS);
+    printf("BENCH ccsds_header_decode: %.2f ns/op\n", (double)decode_ns / BENCH_ITERATIONS);
+}
+
+#ifndef ESP_PLATFORM
+int main(void) {
+    BENCH_CCSDS_Header();
+    return 0;
+}
+#endif
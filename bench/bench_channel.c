@@ -0,0 +1,139 @@
+/**
+ * @brief Link-layer benchmark: frames through the simulated channel into
+ * the flight parser, swept over bit error rate.
+ *
+ * For every channel setting, BENCH_FRAMES CCSDS telecommands are framed
+ * with COMMS_CreateFrame, passed through CHSIM_Transmit and fed to
+ * COMMS_ParseByte one byte at a time. A route hook checks each delivered
+ * packet against what was sent. Reported per row:
+ *   fps      frames per second through channel + parser (host CPU)
+ *   FER      frames sent but not delivered intact
+ *   goodput  intact app data bytes / bytes put on the channel
+ *   false    packets delivered with wrong content (CRC-16 false accepts)
+ *
+ * Host: built by the host CMake build (target bench_channel).
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "channel_sim.h"
+#include "comms_frame.h"
+#include "ccsds_packet.h"
+
+#define BENCH_FRAMES   10000
+#define BENCH_APP_LEN  24
+#define BENCH_GAP      4      // Idle bytes between frames
+
+typedef struct {
+    const char *label;
+    chsim_config_t cfg;
+} bench_case_t;
+
+static struct {
+    uint32_t delivered;
+    uint32_t intact;
+    uint32_t false_accepts;
+} rx_tally;
+
+static void bench_app_data(uint32_t index, uint8_t *out) {
+    uint32_t x = index * 2654435761u;
+    for (int i = 0; i < BENCH_APP_LEN; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        out[i] = (uint8_t)x;
+    }
+}
+
+// Route hook: the MET field carries the frame index
+static void bench_route(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view) {
+    uint8_t expect[BENCH_APP_LEN];
+    (void)packet;
+    (void)len;
+    rx_tally.delivered++;
+
+    if (view->mission_time < BENCH_FRAMES && view->app_data_len == BENCH_APP_LEN) {
+        bench_app_data((uint32_t)view->mission_time, expect);
+        if (memcmp(expect, view->app_data, BENCH_APP_LEN) == 0) {
+            rx_tally.intact++;
+            return;
+        }
+    }
+    rx_tally.false_accepts++;
+}
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void run_case(const bench_case_t *bc) {
+    static uint8_t tx[BENCH_FRAMES * (MAX_FRAME_SIZE + BENCH_GAP)];
+    static uint8_t rx[sizeof(tx) * 2];
+    size_t tx_len = 0;
+
+    // 1. Build the stream
+    for (uint32_t i = 0; i < BENCH_FRAMES; i++) {
+        uint8_t pkt[CCSDS_HEADERS_SIZE + BENCH_APP_LEN];
+        comms_frame_t frame;
+        CCSDS_BuildHeaders(pkt, APID_CDHS, (uint16_t)(0xC000u | (i & 0x3FFFu)), BENCH_APP_LEN, i);
+        bench_app_data(i, &pkt[CCSDS_HEADERS_SIZE]);
+        COMMS_CreateFrame(&frame, pkt, sizeof(pkt));
+
+        tx_len += COMMS_SerializeFrame(&frame, &tx[tx_len]);
+        memset(&tx[tx_len], 0x55, BENCH_GAP);
+        tx_len += BENCH_GAP;
+    }
+
+    // 2. Channel + parser, timed together
+    chsim_channel_t ch;
+    CHSIM_Init(&ch, &bc->cfg);
+    memset(&rx_tally, 0, sizeof(rx_tally));
+    COMMS_ResetParser();
+    COMMS_ResetReplayWindows();
+
+    double start = now_s();
+    size_t rx_len = CHSIM_Transmit(&ch, tx, tx_len, rx, sizeof(rx));
+    for (size_t i = 0; i < rx_len; i++) {
+        COMMS_ParseByte(rx[i]);
+    }
+    double elapsed = now_s() - start;
+
+    chsim_stats_t st;
+    CHSIM_GetStats(&ch, &st);
+    printf("%-18s %8.0f  %7.4f  %6.1f%%  %6u  %llu\n", bc->label,
+           BENCH_FRAMES / elapsed,
+           1.0 - (double)rx_tally.intact / BENCH_FRAMES,
+           100.0 * rx_tally.intact * BENCH_APP_LEN / (double)tx_len,
+           rx_tally.false_accepts,
+           (unsigned long long)st.bits_flipped);
+}
+
+void BENCH_Channel(void) {
+    static const bench_case_t cases[] = {
+        { "clean",            { .seed = 1 } },
+        { "BER 1e-6",         { .seed = 1, .ber = 1e-6 } },
+        { "BER 1e-5",         { .seed = 1, .ber = 1e-5 } },
+        { "BER 1e-4",         { .seed = 1, .ber = 1e-4 } },
+        { "BER 1e-3",         { .seed = 1, .ber = 1e-3 } },
+        { "BER 3e-3",         { .seed = 1, .ber = 3e-3 } },
+        { "BER 1e-2",         { .seed = 1, .ber = 1e-2 } },
+        { "GE bursts",        { .seed = 1, .burst = true, .ge_p_good_to_bad = 1e-4,
+                                .ge_p_bad_to_good = 0.01, .ge_ber_bad = 0.1 } },
+        { "slips 1e-4",       { .seed = 1, .drop_prob = 1e-4, .insert_prob = 1e-4 } },
+        { "dropouts",         { .seed = 1, .dropout_prob = 1e-4, .dropout_len = 200 } },
+    };
+
+    COMMS_SetRouteHandler(bench_route);
+    printf("%-18s %8s  %7s  %7s  %6s  %s\n", "channel", "fps", "FER", "goodput", "false", "bit flips");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        run_case(&cases[i]);
+    }
+    COMMS_SetRouteHandler(NULL);
+}
+
+#ifndef ESP_PLATFORM
+int main(void) {
+    BENCH_Channel();
+    return 0;
+}
+#endif
@@ -0,0 +1,205 @@
+/**
+ * @brief Micro-benchmarks for the link-layer hot paths.
+ *
+ *   crc16/N         COMMS_CalculateCRC16 over N bytes (up to 4 KB profiles)
+ *   create_frame/N  COMMS_CreateFrame with an N-byte payload
+ *   ccsds_wrap/N    CCSDS_WrapTelemetry with N bytes of app data
+ *   parse_clean/N   COMMS_ParseByte over 64 back-to-back N-byte frames
+ *   parse_noisy/N   The same stream after a BER 1e-3 + slip channel
+ *
+ * Each runs warm (calibrated loop) and the key sizes also cold (caches
+ * evicted before every call). The parse streams carry valid CCSDS
+ * telecommands and the replay windows are cleared before every pass, so
+ * each clean frame takes the full validation path into the route hook. A
+ * clean pass that routes fewer bytes than it carries fails the run.
+ *
+ *   bench_comms [--json out.json] [--min-time ms] [--filter substring]
+ *
+ * Compare two JSON runs with tools/bench_compare.py.
+ * Target: call BENCH_Comms() from app_main().
+ */
+#include <stdio.h>
+#include <string.h>
+#include "bench_harness.h"
+#include "comms_frame.h"
+#include "ccsds_packet.h"
+#include "channel_sim.h"
+
+#define STREAM_FRAMES 64
+
+typedef struct {
+    uint8_t data[4096];
+    uint32_t len;
+} bench_buf_t;
+
+typedef struct {
+    uint8_t bytes[STREAM_FRAMES * (MAX_PAYLOAD_SIZE + 4) * 2];
+    uint32_t len;
+    uint32_t routed_per_pass;   // Bytes the route hook must see per pass (0 = unchecked)
+    uint64_t short_passes;      // Passes that routed less than that
+} bench_stream_t;
+
+static const char *bench_filter;
+static uint64_t routed_bytes;
+
+static void bench_crc(void *ctx, uint64_t iters) {
+    bench_buf_t *b = ctx;
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        b->data[0] = (uint8_t)i;
+        acc += COMMS_CalculateCRC16(b->data, b->len);
+    }
+    bench_sink = acc;
+}
+
+static void bench_create_frame(void *ctx, uint64_t iters) {
+    bench_buf_t *b = ctx;
+    comms_frame_t frame;
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        b->data[0] = (uint8_t)i;
+        COMMS_CreateFrame(&frame, b->data, (uint8_t)b->len);
+        acc += frame.crc;
+    }
+    bench_sink = acc;
+}
+
+static void bench_ccsds_wrap(void *ctx, uint64_t iters) {
+    bench_buf_t *b = ctx;
+    static uint8_t out[CCSDS_HEADERS_SIZE + MAX_PAYLOAD_SIZE];
+    for (uint64_t i = 0; i < iters; i++) {
+        CCSDS_WrapTelemetry((uint16_t)(i & 0x07FF), b->data, (uint16_t)b->len, out);
+    }
+    bench_sink = out[CCSDS_HEADERS_SIZE - 1];
+}
+
+static void bench_parse(void *ctx, uint64_t iters) {
+    bench_stream_t *s = ctx;
+    uint64_t found = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        // Every pass reuses the same sequence counts: forget the last one
+        COMMS_ResetReplayWindows();
+        uint64_t before = routed_bytes;
+        for (uint32_t j = 0; j < s->len; j++) {
+            found += (uint64_t)COMMS_ParseByte(s->bytes[j]);
+        }
+        if (s->routed_per_pass != 0 && routed_bytes - before != s->routed_per_pass) s->short_passes++;
+    }
+    bench_sink = found;
+}
+
+static void bench_route_sink(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view) {
+    (void)packet;
+    (void)view;
+    routed_bytes += len;
+}
+
+// STREAM_FRAMES CCSDS telecommands framed back to back, `size` bytes of frame payload each
+static void build_stream(bench_stream_t *s, uint8_t size) {
+    uint8_t pkt[MAX_PAYLOAD_SIZE];
+    comms_frame_t frame;
+    uint16_t app_len = (uint16_t)(size - CCSDS_HEADERS_SIZE);
+
+    s->len = 0;
+    s->routed_per_pass = STREAM_FRAMES * size;
+    s->short_passes = 0;
+    for (uint32_t i = 0; i < STREAM_FRAMES; i++) {
+        CCSDS_BuildHeaders(pkt, APID_CDHS, (uint16_t)(0xC000u | i), app_len, i);
+        memset(&pkt[CCSDS_HEADERS_SIZE], (int)i, app_len);
+        COMMS_CreateFrame(&frame, pkt, size);
+        s->len += COMMS_SerializeFrame(&frame, &s->bytes[s->len]);
+    }
+}
+
+static void add_noise(bench_stream_t *s) {
+    static uint8_t clean[sizeof(s->bytes)];
+    chsim_channel_t ch;
+    chsim_config_t cfg = { .seed = 2024, .ber = 1e-3, .drop_prob = 1e-4, .insert_prob = 1e-4 };
+    memcpy(clean, s->bytes, s->len);
+    CHSIM_Init(&ch, &cfg);
+    s->len = (uint32_t)CHSIM_Transmit(&ch, clean, s->len, s->bytes, sizeof(s->bytes));
+    s->routed_per_pass = 0;   // Some frames are meant to be lost
+}
+
+static void run(const char *fmt, unsigned size, bench_fn fn, void *ctx,
+                uint32_t bytes, uint32_t frames, bool cold) {
+    char name[48];
+    snprintf(name, sizeof(name), fmt, size);
+    if (bench_filter && strstr(name, bench_filter) == NULL) return;
+    BENCH_Measure(name, fn, ctx, bytes, frames, cold);
+}
+
+// @return 0, or -1 if a clean parse stream did not reach the route hook intact
+int BENCH_Comms(FILE *json) {
+    static bench_buf_t buf;
+    static bench_stream_t stream;
+    static const unsigned crc_sizes[] = {1, 16, 64, 256, 1024, 4096};
+    static const unsigned frame_sizes[] = {1, 16, 32, MAX_PAYLOAD_SIZE};
+    static const unsigned wrap_sizes[] = {1, 16, MAX_PAYLOAD_SIZE - CCSDS_HEADERS_SIZE};
+    static const unsigned parse_sizes[] = {16, 32, MAX_PAYLOAD_SIZE};
+    int rc = 0;
+
+    for (unsigned i = 0; i < sizeof(buf.data); i++) buf.data[i] = (uint8_t)(i * 31u);
+    COMMS_SetRouteHandler(bench_route_sink);
+
+    for (unsigned i = 0; i < sizeof(crc_sizes) / sizeof(crc_sizes[0]); i++) {
+        buf.len = crc_sizes[i];
+        run("crc16/%u", buf.len, bench_crc, &buf, buf.len, 0, false);
+        if (buf.len == MAX_PAYLOAD_SIZE) run("crc16/%u", buf.len, bench_crc, &buf, buf.len, 0, true);
+    }
+    for (unsigned i = 0; i < sizeof(frame_sizes) / sizeof(frame_sizes[0]); i++) {
+        buf.len = frame_sizes[i];
+        run("create_frame/%u", buf.len, bench_create_frame, &buf, buf.len, 1, false);
+        if (buf.len == MAX_PAYLOAD_SIZE) run("create_frame/%u", buf.len, bench_create_frame, &buf, buf.len, 1, true);
+    }
+    for (unsigned i = 0; i < sizeof(wrap_sizes) / sizeof(wrap_sizes[0]); i++) {
+        buf.len = wrap_sizes[i];
+        run("ccsds_wrap/%u", buf.len, bench_ccsds_wrap, &buf, buf.len, 1, false);
+    }
+    for (unsigned i = 0; i < sizeof(parse_sizes) / sizeof(parse_sizes[0]); i++) {
+        unsigned size = parse_sizes[i];
+        build_stream(&stream, (uint8_t)size);
+        COMMS_ResetParser();
+        run("parse_clean/%u", size, bench_parse, &stream, stream.len, STREAM_FRAMES, false);
+        if (size == MAX_PAYLOAD_SIZE) run("parse_clean/%u", size, bench_parse, &stream, stream.len, STREAM_FRAMES, true);
+        if (stream.short_passes != 0) {
+            fprintf(stderr, "parse_clean/%u: %llu passes did not route every frame\n",
+                    size, (unsigned long long)stream.short_passes);
+            rc = -1;
+        }
+
+        add_noise(&stream);
+        COMMS_ResetParser();
+        run("parse_noisy/%u", size, bench_parse, &stream, stream.len, STREAM_FRAMES, false);
+    }
+
+    COMMS_SetRouteHandler(NULL);
+    COMMS_ResetReplayWindows();
+    BENCH_Report(json);
+    return rc;
+}
+
+#ifndef ESP_PLATFORM
+int main(int argc, char **argv) {
+    FILE *json = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json = fopen(argv[++i], "w");
+            if (json == NULL) {
+                perror(argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            bench_min_time_ms = (unsigned)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            bench_filter = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--json out.json] [--min-time ms] [--filter substring]\n", argv[0]);
+            return 2;
+        }
+    }
+    int rc = BENCH_Comms(json);
+    if (json) fclose(json);
+    return (rc == 0) ? 0 : 1;
+}
+#endif
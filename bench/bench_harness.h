@@ -0,0 +1,137 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+/**
+ * @brief Minimal benchmark harness shared by the bench/ drivers.
+ *
+ * Warm runs calibrate the iteration count until one run lasts at least
+ * bench_min_time_ms, then repeat BENCH_REPEATS times and keep the median.
+ * Cold runs evict the data caches before every single call and time each
+ * call on its own. Results collect in a table that BENCH_Report prints
+ * for humans and, optionally, as JSON for tools/bench_compare.py.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_timer.h"
+static inline uint64_t bench_now_ns(void) { return (uint64_t)esp_timer_get_time() * 1000ULL; }
+#define BENCH_EVICT_BYTES (64 * 1024)
+#else
+#include <time.h>
+static inline uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+#define BENCH_EVICT_BYTES (32 * 1024 * 1024)   // Larger than any host LLC
+#endif
+
+#define BENCH_MAX_RESULTS 128
+#define BENCH_REPEATS     5
+#define BENCH_COLD_SAMPLES 51
+
+// Runs the operation under test `iters` times
+typedef void (*bench_fn)(void *ctx, uint64_t iters);
+
+typedef struct {
+    char name[48];
+    bool cold;
+    uint32_t bytes_per_op;
+    uint32_t frames_per_op;
+    uint64_t iterations;
+    double ns_per_op;
+} bench_result_t;
+
+static bench_result_t bench_results[BENCH_MAX_RESULTS];
+static unsigned bench_count;
+static unsigned bench_min_time_ms = 20;
+static volatile uint64_t bench_sink;   // Keeps results observable
+
+static int bench_cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void bench_evict_caches(void) {
+    static uint8_t *junk;
+    if (junk == NULL) junk = malloc(BENCH_EVICT_BYTES);
+    if (junk == NULL) return;
+    for (size_t i = 0; i < BENCH_EVICT_BYTES; i += 64) {
+        junk[i]++;
+    }
+    bench_sink += junk[BENCH_EVICT_BYTES / 2];
+}
+
+static void BENCH_Measure(const char *name, bench_fn fn, void *ctx,
+                          uint32_t bytes_per_op, uint32_t frames_per_op, bool cold) {
+    if (bench_count >= BENCH_MAX_RESULTS) return;
+    bench_result_t *r = &bench_results[bench_count++];
+    double samples[BENCH_COLD_SAMPLES];
+    int n;
+
+    if (cold) {
+        // 1. One call per sample, caches flushed in between (not timed)
+        for (n = 0; n < BENCH_COLD_SAMPLES; n++) {
+            bench_evict_caches();
+            uint64_t t0 = bench_now_ns();
+            fn(ctx, 1);
+            samples[n] = (double)(bench_now_ns() - t0);
+        }
+        r->iterations = BENCH_COLD_SAMPLES;
+    } else {
+        // 2. Grow the batch until it runs for the minimum time
+        uint64_t iters = 1;
+        for (;;) {
+            uint64_t t0 = bench_now_ns();
+            fn(ctx, iters);
+            uint64_t dt = bench_now_ns() - t0;
+            if (dt >= (uint64_t)bench_min_time_ms * 1000000ULL || iters >= (1ULL << 40)) break;
+            iters *= (dt < 1000000ULL) ? 10 : 2;
+        }
+        for (n = 0; n < BENCH_REPEATS; n++) {
+            uint64_t t0 = bench_now_ns();
+            fn(ctx, iters);
+            samples[n] = (double)(bench_now_ns() - t0) / (double)iters;
+        }
+        r->iterations = iters * BENCH_REPEATS;
+    }
+
+    qsort(samples, (size_t)n, sizeof(samples[0]), bench_cmp_double);
+    snprintf(r->name, sizeof(r->name), "%s", name);
+    r->cold = cold;
+    r->bytes_per_op = bytes_per_op;
+    r->frames_per_op = frames_per_op;
+    r->ns_per_op = samples[n / 2];
+}
+
+static void BENCH_Report(FILE *json) {
+    printf("%-32s %-5s %12s %10s %14s\n", "benchmark", "cache", "ns/op", "ns/byte", "frames/s");
+    for (unsigned i = 0; i < bench_count; i++) {
+        const bench_result_t *r = &bench_results[i];
+        printf("%-32s %-5s %12.1f", r->name, r->cold ? "cold" : "warm", r->ns_per_op);
+        if (r->bytes_per_op) printf(" %10.3f", r->ns_per_op / r->bytes_per_op); else printf(" %10s", "-");
+        if (r->frames_per_op) printf(" %14.0f\n", r->frames_per_op * 1e9 / r->ns_per_op); else printf(" %14s\n", "-");
+    }
+    if (json == NULL) return;
+
+    fprintf(json, "{\n  \"min_time_ms\": %u,\n  \"results\": [\n", bench_min_time_ms);
+    for (unsigned i = 0; i < bench_count; i++) {
+        const bench_result_t *r = &bench_results[i];
+        fprintf(json, "    {\"name\": \"%s\", \"cache\": \"%s\", \"iterations\": %llu, "
+                      "\"ns_per_op\": %.3f, \"bytes_per_op\": %u, \"ns_per_byte\": %.4f, "
+                      "\"frames_per_s\": %.1f}%s\n",
+                r->name, r->cold ? "cold" : "warm", (unsigned long long)r->iterations,
+                r->ns_per_op, r->bytes_per_op,
+                r->bytes_per_op ? r->ns_per_op / r->bytes_per_op : 0.0,
+                r->frames_per_op ? r->frames_per_op * 1e9 / r->ns_per_op : 0.0,
+                (i + 1 < bench_count) ? "," : "");
+    }
+    fprintf(json, "  ]\n}\n");
+}
+
+#endif
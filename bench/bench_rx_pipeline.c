@@ -0,0 +1,134 @@
+/**
+ * @brief Inline vs two-stage receive: parser throughput against handler cost.
+ *
+ * BENCH_FRAMES max-length telecommands are fed through the parser twice per
+ * handler cost: once inline (COMMS_ParseByte calls the handler directly, as
+ * without the pipeline) and once through RXP_Receive with the handler on
+ * stage 2. Reported per row:
+ *   ingest   time until every byte has been parsed
+ *   total    time until every accepted packet has been handled
+ *   dropped  packets lost to a full frame ring (pipeline only)
+ *
+ * With a costly handler the pipelined ingest time stays flat while inline
+ * parsing slows with it. On a single-core host both stages share the CPU,
+ * so only the target (two cores) shows the full overlap.
+ *
+ * Host: built by the host CMake build (target bench_rx_pipeline).
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include "rx_pipeline.h"
+#include "comms_frame.h"
+#include "ccsds_packet.h"
+
+#define BENCH_FRAMES  2000
+#define BENCH_CHUNK   64      // Bytes per radio read
+
+static uint8_t stream[BENCH_FRAMES * (MAX_PAYLOAD_SIZE + 4)];
+static size_t stream_len;
+static uint64_t handler_ns;
+static volatile uint32_t handled;
+
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Stands in for a command handler that does real work
+static void busy_handler(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view) {
+    (void)packet;
+    (void)len;
+    (void)view;
+    uint64_t until = bench_now_ns() + handler_ns;
+    while (handler_ns != 0 && bench_now_ns() < until) {
+    }
+    handled++;
+}
+
+static void build_stream(void) {
+    uint8_t pkt[MAX_PAYLOAD_SIZE];
+    comms_frame_t frame;
+
+    stream_len = 0;
+    for (uint16_t seq = 0; seq < BENCH_FRAMES; seq++) {
+        CCSDS_BuildHeaders(pkt, APID_CDHS, (uint16_t)(0xC000 | seq), MAX_PAYLOAD_SIZE - CCSDS_HEADERS_SIZE, seq);
+        memset(&pkt[CCSDS_HEADERS_SIZE], 0x5A, MAX_PAYLOAD_SIZE - CCSDS_HEADERS_SIZE);
+        COMMS_CreateFrame(&frame, pkt, MAX_PAYLOAD_SIZE);
+        stream_len += COMMS_SerializeFrame(&frame, &stream[stream_len]);
+    }
+}
+
+static void run_inline(double *ingest_ms) {
+    COMMS_ResetParser();
+    COMMS_ResetReplayWindows();
+    COMMS_SetRouteHandler(busy_handler);
+    handled = 0;
+
+    uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < stream_len; i++) COMMS_ParseByte(stream[i]);
+    *ingest_ms = (double)(bench_now_ns() - start) / 1e6;
+    COMMS_SetRouteHandler(NULL);
+}
+
+static void run_pipeline(double *ingest_ms, double *total_ms, uint32_t *dropped) {
+    rxp_config_t cfg;
+    rxp_stats_t stats;
+
+    COMMS_ResetReplayWindows();
+    RXP_DefaultConfig(&cfg);
+    cfg.dispatch = busy_handler;
+    handled = 0;
+    if (RXP_Start(&cfg) != 0) {
+        printf("RXP_Start failed\n");
+        return;
+    }
+
+    // 1. Radio side: hand over chunks, retrying only when the byte ring is full
+    uint64_t start = bench_now_ns();
+    for (size_t pos = 0; pos < stream_len;) {
+        size_t n = stream_len - pos < BENCH_CHUNK ? stream_len - pos : BENCH_CHUNK;
+        size_t accepted = RXP_Receive(&stream[pos], n);
+        if (accepted == 0) sched_yield();   // Don't steal the core from stage 1
+        pos += accepted;
+    }
+
+    // 2. Ingest is done once every frame is either queued or dropped
+    do {
+        sched_yield();
+        RXP_GetStats(&stats);
+    } while (stats.frames_queued + stats.frames_dropped < BENCH_FRAMES);
+    *ingest_ms = (double)(bench_now_ns() - start) / 1e6;
+
+    RXP_WaitIdle(60000);
+    *total_ms = (double)(bench_now_ns() - start) / 1e6;
+    RXP_GetStats(&stats);
+    *dropped = stats.frames_dropped;
+    RXP_Stop();
+}
+
+void BENCH_RxPipeline(void) {
+    static const uint64_t costs_ns[] = {0, 1000, 10000, 50000};
+
+    build_stream();
+    printf("%-10s %14s %14s %14s %8s\n", "handler", "inline ms", "pipe ingest", "pipe total", "dropped");
+    for (size_t c = 0; c < sizeof(costs_ns) / sizeof(costs_ns[0]); c++) {
+        double inline_ms = 0, ingest_ms = 0, total_ms = 0;
+        uint32_t dropped = 0;
+
+        handler_ns = costs_ns[c];
+        run_inline(&inline_ms);
+        run_pipeline(&ingest_ms, &total_ms, &dropped);
+        printf("%7lu us %14.2f %14.2f %14.2f %8u\n", (unsigned long)(costs_ns[c] / 1000),
+               inline_ms, ingest_ms, total_ms, dropped);
+    }
+}
+
+#ifndef ESP_PLATFORM
+int main(void) {
+    BENCH_RxPipeline();
+    return 0;
+}
+#endif
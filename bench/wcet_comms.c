@@ -0,0 +1,444 @@
+/**
+ * @brief Worst-case execution time harness for COMMS_ParseByte and dispatch.
+ *
+ * Every scenario replays an adversarial byte stream through the parser
+ * (or calls the dispatcher directly) and times each call on its own with
+ * CYCLES_Now(). Samples are keyed by the role the byte plays in its frame,
+ * so each parser state transition gets its own maximum:
+ *
+ *   false_sync     start byte then an invalid length, over and over
+ *   frame_routed   back-to-back max-length telecommands, CRC ok, dispatched
+ *   frame_bad_crc  max-length frames failing the CRC check
+ *   frame_filtered max-length frames for an APID the filter drops
+ *   frame_bad_tc   max-length frames failing CCSDS validation
+ *   dispatch_max   COMMS_DispatchTelecommand with the longest argument list
+ *   dispatch_reject COMMS_DispatchTelecommand for an unregistered command
+ *
+ * Each stream is replayed from a reset parser many times and every call
+ * goes into a per-role histogram, cold caches, mispredicted branches and
+ * all. The gated WCET is a high percentile of those calls (--percentile,
+ * default 99.9): on a host OS the last few samples are preemption, not
+ * the code; on bare target hardware use --percentile 100 to gate the
+ * absolute max. Reported alongside: the absolute max, the mean, and "best",
+ * the slowest stream position taking its fastest pass (the worst input
+ * path with every cache warm).
+ *
+ *   wcet_comms [--passes N] [--percentile P] [--json out.json]
+ *              [--budget file] [--write-budget file] [--margin 2.0]
+ *
+ * With --budget the run fails (exit 1) if any WCET exceeds its budget.
+ * Budget files are per machine and build type: lines of "scenario role
+ * cycles", under a header recording the build type and CPU they were
+ * measured on. A budget from another build type, CPU or percentile is
+ * refused outright.
+ * Target: call WCET_Comms() from app_main(); the report goes to stdout.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cycle_counter.h"
+#include "comms_frame.h"
+#include "ccsds_packet.h"
+#include "byte_order.h"
+
+#ifndef ESP_PLATFORM
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define WCET_STREAM_FRAMES 64
+#define WCET_DISPATCH_RUN  16     // Back-to-back dispatcher calls per pass
+#define WCET_CMD           0x42
+#define WCET_BUDGET_SLACK  64     // Cycles added to every budget so single-digit paths don't flap
+#define WCET_HIST_BUCKETS  240    // 16 exact, then 8 per power of two up to 2^32
+
+#ifndef WCET_BUILD_TYPE
+#define WCET_BUILD_TYPE    "unknown"   // Set by CMake from CMAKE_BUILD_TYPE
+#endif
+
+typedef enum {
+    ROLE_START = 0,
+    ROLE_LENGTH,
+    ROLE_PAYLOAD,
+    ROLE_CRC_HI,
+    ROLE_CRC_LO,     // CRC check, filters, routing and dispatch
+    ROLE_CALL,       // Direct dispatcher call
+    ROLE_COUNT
+} wcet_role_t;
+
+static const char *role_names[ROLE_COUNT] = { "start", "length", "payload", "crc_hi", "crc_complete", "call" };
+
+typedef struct {
+    const char *scenario;
+    wcet_role_t role;
+    uint32_t wcet;          // Gated percentile of every call
+    uint32_t max;
+    uint32_t best;          // Slowest position, fastest pass
+    double mean;
+    uint64_t samples;
+} wcet_result_t;
+
+static wcet_result_t results[64];
+static unsigned result_count;
+
+static uint8_t stream[WCET_STREAM_FRAMES * (MAX_PAYLOAD_SIZE + 4)];
+static uint8_t roles[sizeof(stream)];
+static uint32_t best[sizeof(stream)];
+static uint64_t hist[ROLE_COUNT][WCET_HIST_BUCKETS];
+static size_t stream_len;
+
+static uint32_t passes = 2000;
+static double percentile = 99.9;
+static uint32_t timer_overhead;
+
+static void wcet_handler(const uint8_t *args, uint8_t args_len) {
+    (void)args;
+    (void)args_len;
+}
+
+static void wcet_route(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view) {
+    (void)packet;
+    (void)len;
+    COMMS_DispatchTelecommand(view);
+}
+
+static void push(uint8_t byte, wcet_role_t role) {
+    if (stream_len >= sizeof(stream)) return;
+    stream[stream_len] = byte;
+    roles[stream_len++] = (uint8_t)role;
+}
+
+// One max-length frame carrying a telecommand for WCET_CMD with all-args
+static void push_frame(uint16_t apid, uint16_t seq, uint8_t version_bits, bool bad_crc) {
+    uint8_t pkt[MAX_PAYLOAD_SIZE];
+    comms_frame_t frame;
+    uint16_t app_len = MAX_PAYLOAD_SIZE - CCSDS_HEADERS_SIZE;
+
+    CCSDS_BuildHeaders(pkt, apid, (uint16_t)(0xC000u | (seq & 0x3FFFu)), app_len, seq);
+    pkt[0] |= version_bits;
+    memset(&pkt[CCSDS_HEADERS_SIZE], 0x5A, app_len);
+    pkt[CCSDS_HEADERS_SIZE] = WCET_CMD;
+    COMMS_CreateFrame(&frame, pkt, MAX_PAYLOAD_SIZE);
+    if (bad_crc) frame.crc ^= 0x0001;
+
+    uint8_t wire[MAX_FRAME_SIZE];
+    uint16_t wire_len = COMMS_SerializeFrame(&frame, wire);
+    push(wire[0], ROLE_START);
+    push(wire[1], ROLE_LENGTH);
+    for (int i = 2; i < wire_len - 2; i++) push(wire[i], ROLE_PAYLOAD);
+    push(wire[wire_len - 2], ROLE_CRC_HI);
+    push(wire[wire_len - 1], ROLE_CRC_LO);
+}
+
+static inline uint32_t net(uint32_t dt) {
+    return dt > timer_overhead ? dt - timer_overhead : 0;
+}
+
+// Log-linear buckets: exact below 16, then within 1/8 of the value
+static inline unsigned hist_bucket(uint32_t v) {
+    if (v < 16) return v;
+    unsigned e = 31u - (unsigned)__builtin_clz(v);
+    return 16u + (e - 4u) * 8u + ((v >> (e - 3u)) & 7u);
+}
+
+static uint32_t hist_upper(unsigned b) {
+    if (b < 16) return b;
+    unsigned e = (b - 16u) / 8u + 4u;
+    return (uint32_t)(((uint64_t)(8u + (b - 16u) % 8u + 1u) << (e - 3u)) - 1u);
+}
+
+static inline void sample(wcet_role_t role, uint32_t dt, uint32_t *max, uint64_t *sum) {
+    if (dt > max[role]) max[role] = dt;
+    sum[role] += dt;
+    hist[role][hist_bucket(dt)]++;
+}
+
+// Upper edge of the bucket holding the requested percentile, never above max
+static uint32_t hist_percentile(const uint64_t *h, uint64_t count, uint32_t max) {
+    uint64_t rank = (uint64_t)((double)count * percentile / 100.0 + 0.999999);
+    uint64_t seen = 0;
+    if (rank == 0) rank = 1;
+    for (unsigned b = 0; b < WCET_HIST_BUCKETS; b++) {
+        seen += h[b];
+        if (seen >= rank) return hist_upper(b) < max ? hist_upper(b) : max;
+    }
+    return max;
+}
+
+static void record(const char *scenario, const uint8_t *role_of, size_t positions,
+                   const uint32_t *max, const uint64_t *sum) {
+    uint32_t slowest[ROLE_COUNT] = {0};
+    uint64_t count[ROLE_COUNT] = {0};
+
+    for (size_t i = 0; i < positions; i++) {
+        if (best[i] > slowest[role_of[i]]) slowest[role_of[i]] = best[i];
+        count[role_of[i]] += passes;
+    }
+    for (int r = 0; r < ROLE_COUNT; r++) {
+        if (count[r] == 0 || result_count >= sizeof(results) / sizeof(results[0])) continue;
+        wcet_result_t *res = &results[result_count++];
+        res->scenario = scenario;
+        res->role = (wcet_role_t)r;
+        res->wcet = hist_percentile(hist[r], count[r], max[r]);
+        res->max = max[r];
+        res->best = slowest[r];
+        res->mean = (double)sum[r] / (double)count[r];
+        res->samples = count[r];
+    }
+}
+
+static void run_stream(const char *scenario) {
+    uint32_t max[ROLE_COUNT] = {0};
+    uint64_t sum[ROLE_COUNT] = {0};
+
+    for (size_t i = 0; i < stream_len; i++) best[i] = UINT32_MAX;
+    memset(hist, 0, sizeof(hist));
+    for (uint32_t p = 0; p < passes; p++) {
+        // Same starting state every pass, so position i always takes the same path
+        COMMS_ResetParser();
+        COMMS_ResetReplayWindows();
+        for (size_t i = 0; i < stream_len; i++) {
+            uint8_t byte = stream[i];
+
+            uint32_t t0 = CYCLES_Now();
+            COMMS_ParseByte(byte);
+            uint32_t dt = net(CYCLES_Now() - t0);
+
+            if (dt < best[i]) best[i] = dt;
+            sample((wcet_role_t)roles[i], dt, max, sum);
+        }
+    }
+    record(scenario, roles, stream_len, max, sum);
+}
+
+static void run_dispatch(const char *scenario, uint8_t cmd) {
+    static const uint8_t call_roles[WCET_DISPATCH_RUN] = { [0 ... WCET_DISPATCH_RUN - 1] = ROLE_CALL };
+    uint32_t max[ROLE_COUNT] = {0};
+    uint64_t sum[ROLE_COUNT] = {0};
+    uint8_t app[MAX_PAYLOAD_SIZE - CCSDS_HEADERS_SIZE];
+    CCSDS_TcView_t view = { .apid = APID_CDHS, .app_data = app, .app_data_len = sizeof(app) };
+
+    memset(app, 0x5A, sizeof(app));
+    app[0] = cmd;
+    for (int i = 0; i < WCET_DISPATCH_RUN; i++) best[i] = UINT32_MAX;
+    memset(hist, 0, sizeof(hist));
+    for (uint32_t p = 0; p < passes; p++) {
+        for (int i = 0; i < WCET_DISPATCH_RUN; i++) {
+            uint32_t t0 = CYCLES_Now();
+            COMMS_DispatchTelecommand(&view);
+            uint32_t dt = net(CYCLES_Now() - t0);
+            if (dt < best[i]) best[i] = dt;
+            sample(ROLE_CALL, dt, max, sum);
+        }
+    }
+    record(scenario, call_roles, WCET_DISPATCH_RUN, max, sum);
+}
+
+static void calibrate_timer(void) {
+    timer_overhead = UINT32_MAX;
+    for (int i = 0; i < 10000; i++) {
+        uint32_t t0 = CYCLES_Now();
+        uint32_t dt = CYCLES_Now() - t0;
+        if (dt < timer_overhead) timer_overhead = dt;
+    }
+}
+
+void WCET_Comms(void) {
+    calibrate_timer();
+    COMMS_RegisterCommand(WCET_CMD, wcet_handler, 0, MAX_PAYLOAD_SIZE);
+    COMMS_SetRouteHandler(wcet_route);
+
+    // 1. Repeated false syncs: start byte, then an out-of-range length
+    stream_len = 0;
+    for (int i = 0; i < WCET_STREAM_FRAMES; i++) {
+        push(FRAME_START_BYTE, ROLE_START);
+        push((i & 1) ? 0x00 : (uint8_t)(MAX_PAYLOAD_SIZE + 1), ROLE_LENGTH);
+    }
+    run_stream("false_sync");
+
+    // 2. Back-to-back max-length frames down each exit of the CRC state
+    stream_len = 0;
+    for (uint16_t seq = 0; seq < WCET_STREAM_FRAMES; seq++) push_frame(APID_CDHS, seq, 0, false);
+    run_stream("frame_routed");
+
+    stream_len = 0;
+    for (uint16_t seq = 0; seq < WCET_STREAM_FRAMES; seq++) push_frame(APID_CDHS, seq, 0, true);
+    run_stream("frame_bad_crc");
+
+    stream_len = 0;
+    for (uint16_t seq = 0; seq < WCET_STREAM_FRAMES; seq++) push_frame(0x123, seq, 0, false);
+    run_stream("frame_filtered");
+
+    stream_len = 0;
+    for (uint16_t seq = 0; seq < WCET_STREAM_FRAMES; seq++) push_frame(APID_CDHS, seq, 0x20, false);   // Version 1
+    run_stream("frame_bad_tc");
+
+    // 3. Dispatcher on its own (the reject path logs, so stdout is muted on host)
+    run_dispatch("dispatch_max", WCET_CMD);
+#ifndef ESP_PLATFORM
+    fflush(stdout);
+    int saved_stdout = dup(1);
+    int devnull = open("/dev/null", O_WRONLY);
+    if (devnull >= 0) dup2(devnull, 1);
+#endif
+    run_dispatch("dispatch_reject", (uint8_t)(WCET_CMD + 1));
+#ifndef ESP_PLATFORM
+    fflush(stdout);
+    if (saved_stdout >= 0) dup2(saved_stdout, 1);
+    if (devnull >= 0) close(devnull);
+    if (saved_stdout >= 0) close(saved_stdout);
+#endif
+
+    COMMS_SetRouteHandler(NULL);
+    COMMS_UnregisterCommand(WCET_CMD);
+
+    printf("timer overhead %u cycles (subtracted), %u passes per scenario, wcet = p%g of every call\n",
+           timer_overhead, passes, percentile);
+    printf("%-16s %-13s %10s %10s %10s %10s\n", "scenario", "role", "wcet", "max", "best", "mean");
+    for (unsigned i = 0; i < result_count; i++) {
+        const wcet_result_t *r = &results[i];
+        printf("%-16s %-13s %10u %10u %10u %10.1f\n", r->scenario, role_names[r->role],
+               r->wcet, r->max, r->best, r->mean);
+    }
+}
+
+#ifndef ESP_PLATFORM
+static void write_json(const char *path) {
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        perror(path);
+        return;
+    }
+    fprintf(f, "{\n  \"timer_overhead\": %u,\n  \"percentile\": %g,\n  \"results\": [\n",
+            timer_overhead, percentile);
+    for (unsigned i = 0; i < result_count; i++) {
+        const wcet_result_t *r = &results[i];
+        fprintf(f, "    {\"scenario\": \"%s\", \"role\": \"%s\", \"wcet_cycles\": %u, "
+                   "\"max_cycles\": %u, \"best_cycles\": %u, \"mean_cycles\": %.1f, \"samples\": %llu}%s\n",
+                r->scenario, role_names[r->role], r->wcet, r->max, r->best, r->mean,
+                (unsigned long long)r->samples, (i + 1 < result_count) ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+}
+
+// CPU model for the budget header ("unknown" off Linux)
+static void cpu_model(char *out, size_t len) {
+    char line[256];
+    FILE *f = fopen("/proc/cpuinfo", "r");
+    snprintf(out, len, "unknown");
+    if (f == NULL) return;
+    while (fgets(line, sizeof(line), f)) {
+        char *colon = strchr(line, ':');
+        if (strncmp(line, "model name", 10) != 0 || colon == NULL) continue;
+        colon += strspn(colon + 1, " \t") + 1;
+        colon[strcspn(colon, "\n")] = '\0';
+        snprintf(out, len, "%s", colon);
+        break;
+    }
+    fclose(f);
+}
+
+static void write_budget(const char *path, double margin) {
+    char cpu[128];
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        perror(path);
+        return;
+    }
+    cpu_model(cpu, sizeof(cpu));
+    fprintf(f, "# build_type %s\n", WCET_BUILD_TYPE);
+    fprintf(f, "# cpu %s\n", cpu);
+    fprintf(f, "# percentile %g\n", percentile);
+    fprintf(f, "# scenario role budget_cycles (p%g of every call x %.1f + %d)\n",
+            percentile, margin, WCET_BUDGET_SLACK);
+    for (unsigned i = 0; i < result_count; i++) {
+        const wcet_result_t *r = &results[i];
+        fprintf(f, "%s %s %u\n", r->scenario, role_names[r->role], (uint32_t)(r->wcet * margin) + WCET_BUDGET_SLACK);
+    }
+    fclose(f);
+}
+
+// Returns the number of results over budget, or -1 if the file is
+// unreadable or was recorded under another build type, CPU or percentile
+static int check_budget(const char *path) {
+    FILE *f = fopen(path, "r");
+    char line[256], scenario[32], role[32], cpu[128];
+    unsigned budget;
+    double recorded_pct;
+    int over = 0;
+
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+    cpu_model(cpu, sizeof(cpu));
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "# build_type %31s", scenario) == 1 && strcmp(scenario, WCET_BUILD_TYPE) != 0) {
+            printf("%s was recorded for a %s build, this is %s\n", path, scenario, WCET_BUILD_TYPE);
+            fclose(f);
+            return -1;
+        }
+        if (strncmp(line, "# cpu ", 6) == 0) {
+            line[strcspn(line, "\n")] = '\0';
+            if (strcmp(&line[6], cpu) != 0) {
+                printf("%s was recorded on \"%s\", this is \"%s\"\n", path, &line[6], cpu);
+                fclose(f);
+                return -1;
+            }
+            continue;
+        }
+        if (sscanf(line, "# percentile %lf", &recorded_pct) == 1 && recorded_pct != percentile) {
+            printf("%s gates p%g, this run measures p%g\n", path, recorded_pct, percentile);
+            fclose(f);
+            return -1;
+        }
+        if (line[0] == '#' || sscanf(line, "%31s %31s %u", scenario, role, &budget) != 3) continue;
+        for (unsigned i = 0; i < result_count; i++) {
+            const wcet_result_t *r = &results[i];
+            if (strcmp(r->scenario, scenario) != 0 || strcmp(role_names[r->role], role) != 0) continue;
+            if (r->wcet > budget) {
+                printf("WCET BUDGET EXCEEDED: %s %s %u > %u cycles\n", scenario, role, r->wcet, budget);
+                over++;
+            }
+        }
+    }
+    fclose(f);
+    return over;
+}
+
+int main(int argc, char **argv) {
+    const char *json = NULL, *budget = NULL, *new_budget = NULL;
+    double margin = 2.0;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            fprintf(stderr, "usage: %s [--passes N] [--percentile P] [--json f] [--budget f] "
+                            "[--write-budget f] [--margin x]\n", argv[0]);
+            return 2;
+        }
+        if (strcmp(argv[i], "--passes") == 0) passes = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "--percentile") == 0) percentile = atof(argv[++i]);
+        else if (strcmp(argv[i], "--json") == 0) json = argv[++i];
+        else if (strcmp(argv[i], "--budget") == 0) budget = argv[++i];
+        else if (strcmp(argv[i], "--write-budget") == 0) new_budget = argv[++i];
+        else if (strcmp(argv[i], "--margin") == 0) margin = atof(argv[++i]);
+        else {
+            fprintf(stderr, "%s: unknown option %s\n", argv[0], argv[i]);
+            return 2;
+        }
+    }
+    if (passes == 0) passes = 1;
+    if (!(percentile > 0.0 && percentile <= 100.0)) percentile = 100.0;
+
+    WCET_Comms();
+    if (json) write_json(json);
+    if (new_budget) write_budget(new_budget, margin);
+    if (budget) {
+        int over = check_budget(budget);
+        if (over != 0) return 1;
+        printf("all WCETs within %s\n", budget);
+    }
+    return 0;
+}
+#endif
@@ -0,0 +1,12 @@
+#ifndef CDHS_ROUTER_H
+#define CDHS_ROUTER_H
+
+#include <stdint.h>
+
+/**
+ * @brief Host build stand-in for the Cubesat_CDH_FSW router interface.
+ * Same signature as the flight router; see host/src/cdhs_router_stub.c.
+ */
+void CDHS_RoutePacket(const uint8_t* packet, uint16_t len);
+
+#endif
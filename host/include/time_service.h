@@ -0,0 +1,14 @@
+#ifndef TIME_SERVICE_H
+#define TIME_SERVICE_H
+
+#include <stdint.h>
+
+/**
+ * @brief Host build stand-in for the CubeSat_Time_Service MET interface.
+ * MET only advances on TIME_Tick1ms, so host tests are deterministic.
+ */
+void TIME_Init(void);
+void TIME_Tick1ms(void);
+uint64_t TIME_GetMilliseconds(void);
+
+#endif
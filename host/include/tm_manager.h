@@ -0,0 +1,13 @@
+#ifndef TM_MANAGER_H
+#define TM_MANAGER_H
+
+#include <stdint.h>
+
+/**
+ * @brief Host build stand-in for the CDH telemetry manager.
+ * Wraps app data in a CCSDS packet and a comms frame and puts the result
+ * on the shared downlink bus (see host/src/tm_manager_stub.c).
+ */
+void TM_SendReport(uint16_t apid, const uint8_t* data, uint16_t len);
+
+#endif
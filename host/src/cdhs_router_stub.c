@@ -0,0 +1,8 @@
+#include <stdio.h>
+#include "cdhs_router.h"
+#include "ccsds_packet.h"
+
+// Host build: report where the flight router would deliver the packet
+void CDHS_RoutePacket(const uint8_t* packet, uint16_t len) {
+    printf("CDHS: Routing packet to APID 0x%03X (%u bytes)\n", CCSDS_GetAPID(packet), len);
+}
@@ -0,0 +1,15 @@
+#include "time_service.h"
+
+static uint64_t met_ms = 0;
+
+void TIME_Init(void) {
+    met_ms = 0;
+}
+
+void TIME_Tick1ms(void) {
+    met_ms++;
+}
+
+uint64_t TIME_GetMilliseconds(void) {
+    return met_ms;
+}
@@ -0,0 +1,21 @@
+#include <string.h>
+#include "tm_manager.h"
+#include "comms_frame.h"
+#include "ccsds_packet.h"
+#include "byte_order.h"
+
+// The downlink bus is owned by whoever plays the radio (the test harness)
+extern uint8_t shared_downlink_bus[];
+extern uint16_t last_packet_len;
+
+void TM_SendReport(uint16_t apid, const uint8_t* data, uint16_t len) {
+    if (len > MAX_PAYLOAD_SIZE - CCSDS_HEADERS_SIZE) return;
+
+    // [0xAA][Length][CCSDS packet][CRC High][CRC Low]
+    uint16_t pkt_len = (uint16_t)(CCSDS_HEADERS_SIZE + len);
+    CCSDS_WrapTelemetry(apid, data, len, &shared_downlink_bus[2]);
+    shared_downlink_bus[0] = FRAME_START_BYTE;
+    shared_downlink_bus[1] = (uint8_t)pkt_len;
+    BE_Store16(&shared_downlink_bus[2 + pkt_len], COMMS_CalculateCRC16(shared_downlink_bus, pkt_len + 2u));
+    last_packet_len = (uint16_t)(pkt_len + 4u);
+}
@@ -0,0 +1,59 @@
+#ifndef BYTE_ORDER_H
+#define BYTE_ORDER_H
+
+#include <stdint.h>
+
+/**
+ * @brief Alignment-safe Big-Endian (network order) load/store helpers.
+ *
+ * CCSDS fields sit at arbitrary byte offsets inside frames, so casting a
+ * uint8_t* to a wider type is an unaligned access on Xtensa (emulated or a
+ * LoadStoreAlignment exception). These helpers only ever touch single bytes;
+ * GCC/Clang recognise the shift pattern and fuse it into one load + byte swap
+ * on targets that allow unaligned access (x86 MOVBE/BSWAP, AArch64 REV).
+ */
+
+static inline uint16_t BE_Load16(const uint8_t* p) {
+    return (uint16_t)(((uint16_t)p[0] << 8) | (uint16_t)p[1]);
+}
+
+static inline uint32_t BE_Load32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) |
+           ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8)  |
+           ((uint32_t)p[3]);
+}
+
+// 48-bit field (e.g. a whole CCSDS Primary Header) in the low bits of a uint64_t
+static inline uint64_t BE_Load48(const uint8_t* p) {
+    return ((uint64_t)BE_Load16(p) << 32) | (uint64_t)BE_Load32(p + 2);
+}
+
+static inline uint64_t BE_Load64(const uint8_t* p) {
+    return ((uint64_t)BE_Load32(p) << 32) | (uint64_t)BE_Load32(p + 4);
+}
+
+static inline void BE_Store16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)(v >> 8);
+    p[1] = (uint8_t)(v);
+}
+
+static inline void BE_Store32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)(v);
+}
+
+// Stores the low 48 bits of v
+static inline void BE_Store48(uint8_t* p, uint64_t v) {
+    BE_Store16(p, (uint16_t)(v >> 32));
+    BE_Store32(p + 2, (uint32_t)v);
+}
+
+static inline void BE_Store64(uint8_t* p, uint64_t v) {
+    BE_Store32(p, (uint32_t)(v >> 32));
+    BE_Store32(p + 4, (uint32_t)v);
+}
+
+#endif
@@ -16,16 +16,63 @@ typedef struct __attribute__((packed)){
     uint64_t mission_time;     // MET in milliseconds 
 } CCSDS_SecondaryHeader_t;
 
+// Byte offsets inside a packet buffer. Fields are accessed through the
+// byte_order.h helpers rather than by casting to the structs above, since
+// a packet can start at any (unaligned) offset inside a frame.
+#define CCSDS_PRIMARY_HDR_SIZE    6
+#define CCSDS_SECONDARY_HDR_SIZE  8
+#define CCSDS_HEADERS_SIZE        (CCSDS_PRIMARY_HDR_SIZE + CCSDS_SECONDARY_HDR_SIZE)
+
+#define CCSDS_PACKET_ID_OFFSET    0
+#define CCSDS_SEQ_CTRL_OFFSET     2
+#define CCSDS_LENGTH_OFFSET       4
+#define CCSDS_MET_OFFSET          CCSDS_PRIMARY_HDR_SIZE
+
 // Standard APID (Application Process Identifiers)
 #define APID_ADCS    0x010
 #define APID_EPS     0x020
 #define APID_FDIR    0x030
 #define APID_CDHS    0x040
 #define APID_HK      0x050
+#define APID_HK_DELTA 0x051   // Changed-only HK (hk_delta.h), never the HK_Pack layout
 #define APID_ARCHIVE 0x060
 #define APID_PAYLOAD 0x070
 #define APID_IDLE    0x7FF    // CCSDS Standard for Idle/Fill packets
 
+// Valid APID range for uplinked telecommands (0 is reserved, 0x7FF is idle)
+#define CCSDS_TC_APID_MIN 0x001
+#define CCSDS_TC_APID_MAX 0x7FE
+
+// Sequence Flags (top 2 bits of Sequence Control)
+#define CCSDS_SEQ_CONTINUATION 0x0
+#define CCSDS_SEQ_FIRST        0x1
+#define CCSDS_SEQ_LAST         0x2
+#define CCSDS_SEQ_UNSEGMENTED  0x3
+
+// Result of CCSDS_ValidateTelecommand (first failing check wins)
+typedef enum {
+    CCSDS_TC_OK = 0,
+    CCSDS_TC_ERR_VERSION,   // Version number is not 000
+    CCSDS_TC_ERR_TYPE,      // Type bit is 0 (telemetry)
+    CCSDS_TC_ERR_APID,      // APID outside CCSDS_TC_APID_MIN..MAX
+    CCSDS_TC_ERR_LENGTH,    // Packet Length field disagrees with the frame length
+    CCSDS_TC_ERR_SHORT      // Buffer too small to hold a Primary Header
+} CCSDS_TcStatus_t;
+
+/**
+ * @brief Decoded view of a validated telecommand.
+ * Pointers reference the caller's buffer; nothing is copied.
+ */
+typedef struct {
+    uint16_t apid;
+    uint8_t  seq_flags;        // CCSDS_SEQ_*
+    uint16_t seq_count;        // 14-bit Packet Sequence Count
+    bool     has_sec_hdr;
+    uint64_t mission_time;     // MET from the Secondary Header (0 if absent)
+    const uint8_t* app_data;   // First byte after the header(s)
+    uint16_t app_data_len;
+} CCSDS_TcView_t;
+
 
 // Extract APID from a raw buffer
 uint16_t CCSDS_GetAPID(const uint8_t* buffer);
@@ -36,5 +83,19 @@ bool CCSDS_HasSecondaryHeader(const uint8_t* buffer);
 
 void CCSDS_WrapTelemetry(uint16_t apid, const uint8_t* app_data, uint16_t app_data_len, uint8_t* out_buffer);
 
+/**
+ * @brief Writes the Primary + Secondary Headers only (CCSDS_HEADERS_SIZE bytes).
+ * App data is expected to already sit (or be written) right after them.
+ */
+void CCSDS_BuildHeaders(uint8_t* out_buffer, uint16_t apid, uint16_t seq_ctrl, uint16_t app_data_len, uint64_t met);
+
+/**
+ * @brief Single-pass check of an incoming telecommand packet.
+ * @param buffer Start of the CCSDS packet (e.g. the frame payload).
+ * @param frame_len Number of bytes the link layer delivered for this packet.
+ * @param view Filled with the decoded header fields on CCSDS_TC_OK (may be NULL).
+ */
+CCSDS_TcStatus_t CCSDS_ValidateTelecommand(const uint8_t* buffer, uint16_t frame_len, CCSDS_TcView_t* view);
+
 
 #endif
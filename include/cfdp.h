@@ -0,0 +1,214 @@
+#ifndef CFDP_H
+#define CFDP_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "comms_frame.h"
+#include "ccsds_packet.h"
+
+/**
+ * @brief CCSDS File Delivery Protocol (727.0-B-5), Class 1 (unacknowledged).
+ *
+ * Every PDU travels as the app data of one unsegmented CCSDS packet built
+ * by CCSDS_WrapTelemetry, so a PDU is at most CFDP_MAX_PDU bytes. Fixed
+ * header profile: 1-byte entity IDs, 2-byte transaction sequence numbers,
+ * 32-bit file sizes, no PDU CRC (the frame CRC already covers it).
+ *
+ *   Metadata  -> File Data (offset + bytes) x N -> EOF (checksum, size)
+ *
+ * The file checksum is the CFDP modular checksum: the sum mod 2^32 of the
+ * file as big-endian 32-bit words aligned on file offset. Each byte's
+ * contribution depends only on its offset, so it can be accumulated in any
+ * order as data arrives.
+ */
+
+#define CFDP_VERSION            1
+#define CFDP_PDU_HEADER_SIZE    8
+#define CFDP_MAX_PDU            (MAX_PAYLOAD_SIZE - CCSDS_HEADERS_SIZE)
+#define CFDP_FILE_DATA_PER_PDU  (CFDP_MAX_PDU - CFDP_PDU_HEADER_SIZE - 4)
+#define CFDP_MAX_FILENAME       16     // So Metadata fits one PDU
+#define CFDP_READ_CHUNK         (CFDP_FILE_DATA_PER_PDU * 13)   // Bytes per source read
+
+// File directive codes
+#define CFDP_DIR_EOF            0x04
+#define CFDP_DIR_METADATA       0x07
+
+// Condition codes carried by EOF
+#define CFDP_COND_NO_ERROR             0x0
+#define CFDP_COND_FILESTORE_REJECTION  0x4
+#define CFDP_COND_FILE_CHECKSUM_FAILURE 0x5
+#define CFDP_COND_FILE_SIZE_ERROR      0x6
+
+typedef enum {
+    CFDP_PDU_METADATA = 0,
+    CFDP_PDU_FILE_DATA,
+    CFDP_PDU_EOF
+} cfdp_pdu_type_t;
+
+/**
+ * @brief One PDU, as built by CFDP_EncodePdu or parsed by CFDP_DecodePdu
+ * (data then points into the decoded buffer).
+ */
+typedef struct {
+    cfdp_pdu_type_t type;
+    uint8_t source_id;
+    uint8_t dest_id;
+    uint16_t transaction;
+    uint32_t file_size;          // Metadata, EOF
+    uint32_t checksum;           // EOF
+    uint8_t condition;           // EOF
+    uint32_t offset;             // File Data
+    const uint8_t *data;         // File Data
+    uint16_t data_len;
+    char source_name[CFDP_MAX_FILENAME + 1];   // Metadata
+    char dest_name[CFDP_MAX_FILENAME + 1];     // Metadata
+} cfdp_pdu_t;
+
+/**
+ * @brief Adds len bytes found at file offset to a running modular checksum.
+ */
+uint32_t CFDP_Checksum(uint32_t sum, uint32_t offset, const uint8_t *data, size_t len);
+
+/**
+ * @brief Builds one PDU into out (at least CFDP_MAX_PDU bytes).
+ * @return PDU length, or 0 if it would not fit.
+ */
+uint16_t CFDP_EncodePdu(const cfdp_pdu_t *pdu, uint8_t *out);
+
+/**
+ * @brief Parses one PDU. @return 0, or -1 if malformed / unsupported profile.
+ */
+int CFDP_DecodePdu(const uint8_t *pdu, uint16_t len, cfdp_pdu_t *out);
+
+// ---- Sender (flight): constant memory, no allocation ----
+
+/**
+ * @brief Streaming source: copies up to len bytes at offset into buf.
+ * @return Bytes read (short only at end of file) or -1 on error.
+ */
+typedef int (*cfdp_read_fn)(void *ctx, uint32_t offset, uint8_t *buf, uint32_t len);
+
+/**
+ * @brief Receives each finished CCSDS packet (valid until the call returns).
+ */
+typedef void (*cfdp_emit_fn)(const uint8_t *packet, uint16_t len, void *ctx);
+
+typedef struct {
+    uint16_t apid;
+    uint8_t source_id;
+    uint8_t dest_id;
+    uint16_t transaction;
+    const char *source_name;     // At most CFDP_MAX_FILENAME characters
+    const char *dest_name;
+    uint32_t file_size;
+    cfdp_read_fn read;
+    void *read_ctx;
+    cfdp_emit_fn emit;
+    void *emit_ctx;
+} cfdp_send_config_t;
+
+typedef enum {
+    CFDP_TX_IDLE = 0,
+    CFDP_TX_METADATA,
+    CFDP_TX_DATA,
+    CFDP_TX_EOF,
+    CFDP_TX_DONE,
+    CFDP_TX_ERROR                // Source read failed; EOF carried the condition
+} cfdp_tx_state_t;
+
+typedef struct {
+    cfdp_send_config_t cfg;
+    cfdp_tx_state_t state;
+    uint32_t offset;             // Next file offset to send
+    uint32_t checksum;
+    uint8_t condition;
+    uint32_t pdus_sent;
+    uint32_t chunk_offset;       // File offset of chunk[0]
+    uint32_t chunk_len;
+    uint8_t chunk[CFDP_READ_CHUNK];
+} cfdp_sender_t;
+
+// Source adapters: a memory image (mmap'd file or flash partition), or a FILE*
+typedef struct {
+    const uint8_t *base;
+    uint32_t size;
+} cfdp_memory_source_t;
+
+int CFDP_ReadMemory(void *ctx, uint32_t offset, uint8_t *buf, uint32_t len);   // ctx: cfdp_memory_source_t*
+int CFDP_ReadFile(void *ctx, uint32_t offset, uint8_t *buf, uint32_t len);     // ctx: FILE*
+
+/**
+ * @brief Starts a transaction. @return 0, or -1 on a bad configuration.
+ */
+int CFDP_SenderStart(cfdp_sender_t *tx, const cfdp_send_config_t *cfg);
+
+/**
+ * @brief Emits up to max_pdus PDUs (call again as the link has room).
+ * @return State after the step; CFDP_TX_DONE once EOF has gone out.
+ */
+cfdp_tx_state_t CFDP_SenderStep(cfdp_sender_t *tx, uint32_t max_pdus);
+
+// ---- Receiver (ground, host only): sparse file + gap tracking ----
+
+#define CFDP_MAX_EXTENTS  1024   // Disjoint received ranges tracked per transaction
+
+typedef struct {
+    uint32_t start;
+    uint32_t end;                // Exclusive
+} cfdp_extent_t;
+
+typedef enum {
+    CFDP_RX_IDLE = 0,
+    CFDP_RX_RECEIVING,
+    CFDP_RX_COMPLETE,            // EOF seen, no gaps, checksum matches
+    CFDP_RX_INCOMPLETE,          // EOF seen, gaps remain
+    CFDP_RX_CHECKSUM_FAILED,
+    CFDP_RX_ERROR                // File could not be written
+} cfdp_rx_state_t;
+
+typedef struct {
+    char dir[256];
+    char path[512];
+    int fd;
+    cfdp_rx_state_t state;
+    uint8_t source_id;
+    uint16_t transaction;
+    uint32_t file_size;
+    bool eof_seen;
+    uint8_t eof_condition;
+    uint32_t eof_checksum;
+    uint32_t checksum;           // Over every distinct byte received so far
+    uint32_t bytes_received;
+    cfdp_extent_t extents[CFDP_MAX_EXTENTS];
+    uint16_t extent_count;
+    uint32_t pdus;
+    uint32_t duplicate_bytes;
+    uint32_t untracked;          // PDUs written while the extent table was full
+    uint32_t rejected;           // Malformed, out of profile, or data before Metadata
+} cfdp_receiver_t;
+
+/**
+ * @brief Files are created under dir, named by the Metadata dest name.
+ */
+int CFDP_ReceiverInit(cfdp_receiver_t *rx, const char *dir);
+
+/**
+ * @brief Feeds one CCSDS packet carrying a PDU.
+ * A Metadata PDU for a new transaction closes the current file and opens
+ * the next one (truncated and sized as a sparse file). File data after
+ * Metadata may come in any order, before or after EOF; each segment is
+ * written at its offset and only bytes not seen before count toward the
+ * checksum.
+ */
+cfdp_rx_state_t CFDP_ReceiverPacket(cfdp_receiver_t *rx, const uint8_t *packet, uint16_t len);
+
+/**
+ * @brief Missing ranges of the current file, in order.
+ * @return Number of gaps written to out (at most max).
+ */
+int CFDP_ReceiverGaps(const cfdp_receiver_t *rx, cfdp_extent_t *out, int max);
+
+void CFDP_ReceiverClose(cfdp_receiver_t *rx);
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef CHANNEL_SIM_H
+#define CHANNEL_SIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @brief Deterministic software radio channel for host-side link testing.
+ *
+ * Sits between COMMS_CreateFrame and COMMS_ParseByte. Impairments are
+ * applied per byte in this order: dropout (a run of bytes lost), random
+ * byte drop, random byte insertion, then bit errors, either independent
+ * at a fixed BER or from a two-state Gilbert-Elliott burst model.
+ * Everything derives from the seed, so a run can be replayed exactly.
+ */
+
+typedef struct {
+    uint64_t seed;
+
+    double ber;                // Independent bit error rate (ignored in burst mode)
+
+    bool burst;                // Gilbert-Elliott instead of independent errors
+    double ge_p_good_to_bad;   // Per-bit state transition probabilities
+    double ge_p_bad_to_good;
+    double ge_ber_good;
+    double ge_ber_bad;
+
+    double drop_prob;          // Per input byte
+    double insert_prob;        // Per input byte: a random byte goes out first
+    double dropout_prob;       // Per input byte: start of a signal loss
+    uint16_t dropout_len;      // Bytes lost per dropout
+} chsim_config_t;
+
+typedef struct {
+    uint64_t bytes_in;
+    uint64_t bytes_out;
+    uint64_t bits_flipped;
+    uint64_t bytes_dropped;
+    uint64_t bytes_inserted;
+    uint64_t dropouts;
+} chsim_stats_t;
+
+typedef struct {
+    chsim_config_t cfg;
+    uint64_t rng;
+    uint64_t next_error;       // Independent mode: clean bits before the next flip
+    double log_keep;           // ln(1 - ber), cached for the geometric skip
+    bool bad_state;
+    uint16_t dropout_left;
+    chsim_stats_t stats;
+} chsim_channel_t;
+
+void CHSIM_Init(chsim_channel_t *ch, const chsim_config_t *cfg);
+
+/**
+ * @brief Passes len bytes through the channel.
+ * @return Bytes written to out (stops at out_cap; insertions can grow the stream).
+ */
+size_t CHSIM_Transmit(chsim_channel_t *ch, const uint8_t *in, size_t len, uint8_t *out, size_t out_cap);
+
+/**
+ * @brief Uniform random number from the channel's generator (for drivers
+ * that need reproducible test data from the same seed).
+ */
+uint64_t CHSIM_Random(chsim_channel_t *ch);
+
+void CHSIM_GetStats(const chsim_channel_t *ch, chsim_stats_t *out);
+
+#endif
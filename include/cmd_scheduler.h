@@ -0,0 +1,67 @@
+#ifndef CMD_SCHEDULER_H
+#define CMD_SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Time-tagged command store keyed on Mission Elapsed Time.
+ *
+ * A fixed-capacity binary min-heap of release times: O(log n) insert and
+ * cancel, O(1) peek at the next due time. SCHED_Tick() releases due
+ * commands into the normal dispatcher. All calls are expected from the
+ * command-handling task (not from an ISR); on the target that is the
+ * cmd_task started by app_main, which ticks every 10 ms.
+ */
+
+#define SCHED_CAPACITY     2048   // Pending time-tagged commands
+#define SCHED_MAX_CMD_LEN  16     // Command ID + arguments stored per entry
+#define SCHED_NO_COMMAND   UINT64_MAX
+
+// Uplinked wrapper: args = [MET (8 bytes, Big-Endian)] [Command ID] [arguments...]
+#define CMD_TIME_TAGGED    0xC0
+
+typedef int32_t sched_id_t;   // Negative on error
+
+typedef struct {
+    uint32_t inserted;
+    uint32_t released;
+    uint32_t rejected;   // Uplinked CMD_TIME_TAGGED the store could not take
+} sched_stats_t;
+
+/**
+ * @brief Empties the store and registers the CMD_TIME_TAGGED handler.
+ */
+void SCHED_Init(void);
+
+/**
+ * @brief Stores cmd (Command ID + arguments) for release at met_ms.
+ * Commands with equal release times run in insertion order.
+ * @return Handle for SCHED_Cancel, or -1 if full / cmd too long.
+ */
+sched_id_t SCHED_Insert(uint64_t met_ms, const uint8_t *cmd, uint8_t len);
+
+/**
+ * @brief Removes a pending command. @return true if it was still pending.
+ */
+bool SCHED_Cancel(sched_id_t id);
+
+/**
+ * @brief MET of the next due command, or SCHED_NO_COMMAND if empty.
+ */
+uint64_t SCHED_PeekNextTime(void);
+
+/**
+ * @brief Dispatches every command whose time has come (TIME_GetMilliseconds).
+ * @return Number of commands released.
+ */
+int SCHED_Tick(void);
+
+uint16_t SCHED_Count(void);
+
+/**
+ * @brief Counters since SCHED_Init, for housekeeping telemetry.
+ */
+void SCHED_GetStats(sched_stats_t *out);
+
+#endif
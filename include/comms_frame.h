@@ -3,20 +3,19 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
+#include "ccsds_packet.h"
 
 // Frame Constants
 #define FRAME_START_BYTE 0xAA   // Synchronization byte (10101010 in binary)
 #define MAX_PAYLOAD_SIZE 64     // Maximum data size for one packet
+#define MAX_FRAME_SIZE   (MAX_PAYLOAD_SIZE + 4)   // Start + length + payload + CRC on the wire
 
 // Command IDs
 #define CMD_ORBIT_MAINTENANCE 0xA1
 #define CMD_THERMAL_CONTROL  0xB2
 
-// Satellite States (Variables that the commands will change)
-extern uint8_t g_thruster_duration; // How long to fire (seconds)
-extern int8_t g_target_temperature; // Target heat (Celsius)
-extern uint8_t g_heater_status;       // 0 = OFF, 1 = ON
-extern uint32_t g_satellite_altitude; // Altitude in meters
+// Satellite state lives in the parameter database (param_db.h)
 
 /**
  * @brief The Communication Frame Structure
@@ -33,19 +32,126 @@ uint16_t COMMS_CalculateCRC16(const uint8_t *data, size_t length);
 
 /**
  * @brief Packages raw data into a structured frame.
+ * Builds into caller storage and takes no frame_pool block: the caller
+ * already owns a whole comms_frame_t, so a pool copy would only add a
+ * failure path. Flight downlink is framed in place in a pool block by
+ * TM_Reserve / TM_Commit instead.
  * @param frame Pointer to the frame structure to be filled.
  * @param payload Raw data to send.
  * @param length Size of the raw data.
  */
 void COMMS_CreateFrame(comms_frame_t *frame, const uint8_t *payload, uint8_t length);
 
+/**
+ * @brief Writes a frame as it goes over the air: start, length, payload,
+ * CRC (high byte first).
+ * @param out At least frame->length + 4 (MAX_FRAME_SIZE) bytes.
+ * @return Bytes written.
+ */
+uint16_t COMMS_SerializeFrame(const comms_frame_t *frame, uint8_t *out);
+
 /**
  * @brief Processes a single byte received from the radio.
+ * Frames with a valid CRC are only routed if their APID is accepted, their
+ * payload passes CCSDS_ValidateTelecommand and their sequence count is new.
  */
 int COMMS_ParseByte(uint8_t byte);
 
+/**
+ * @brief Runtime APID acceptance filter (2048-bit bitmap).
+ * Frames whose APID is not accepted are dropped by the parser before
+ * validation and routing. The standard subsystem APIDs are accepted at
+ * boot; APID_IDLE can never be accepted.
+ */
+void COMMS_AcceptAPID(uint16_t apid);
+void COMMS_RejectAPID(uint16_t apid);
+void COMMS_ClearAPIDFilter(void);
+bool COMMS_IsAPIDAccepted(uint16_t apid);
+
+/**
+ * @brief Duplicate/replay rejection on the CCSDS Packet Sequence Count.
+ * Each APID keeps a sliding window of the last COMMS_REPLAY_WINDOW counts;
+ * the parser drops repeats and counts older than the window before routing.
+ */
+#define COMMS_REPLAY_WINDOW 32
+
+typedef struct {
+    uint32_t accepted;
+    uint32_t duplicates;   // Already seen inside the window
+    uint32_t stale;        // Older than the window
+    uint32_t released;     // Accepted, then handed back by COMMS_ReleaseSequence
+} comms_replay_stats_t;
+
+bool COMMS_AcceptSequence(uint16_t apid, uint16_t seq_count);
+
+/**
+ * @brief Undoes COMMS_AcceptSequence for a packet the route hand-off could
+ * not take (queue full, pool empty), so the ground's retransmission with the
+ * same count is accepted instead of rejected as a duplicate. Call it from
+ * the route handler, in parser context, before returning.
+ */
+void COMMS_ReleaseSequence(uint16_t apid, uint16_t seq_count);
+void COMMS_ResetReplayWindows(void);
+void COMMS_GetReplayStats(comms_replay_stats_t *out);
+
+/**
+ * @brief Hand-off for packets that passed the APID filter and validation.
+ * packet/view point into the parser's receive buffer and are only valid
+ * during the call; an asynchronous handler must copy them. A handler that
+ * drops the packet for lack of room releases its sequence count with
+ * COMMS_ReleaseSequence.
+ */
+typedef void (*comms_route_fn_t)(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view);
+
+/**
+ * @brief Replaces the route hand-off. NULL restores direct CDHS_RoutePacket.
+ */
+void COMMS_SetRouteHandler(comms_route_fn_t fn);
+
+/**
+ * @brief Decoded header of the last telecommand handed to the router.
+ * Valid for the duration of the CDHS_RoutePacket call, so the command path
+ * does not need to re-parse the Primary/Secondary Headers.
+ */
+const CCSDS_TcView_t* COMMS_GetLastTelecommand(void);
+
+/**
+ * @brief Command handler. args points just past the Command ID byte.
+ */
+typedef void (*comms_cmd_handler_t)(const uint8_t *args, uint8_t args_len);
+
+#define COMMS_MAX_COMMANDS 256
+
+typedef struct {
+    comms_cmd_handler_t handler;
+    uint8_t min_len;   // Minimum argument bytes (Command ID excluded)
+    uint8_t max_len;   // Maximum argument bytes (Command ID excluded)
+} comms_cmd_entry_t;
+
+/**
+ * @brief Registers (or replaces) the handler for a Command ID.
+ * @return 0 on success, -1 if handler is NULL or min_len > max_len.
+ */
+int COMMS_RegisterCommand(uint8_t cmd_id, comms_cmd_handler_t handler, uint8_t min_len, uint8_t max_len);
+
+void COMMS_UnregisterCommand(uint8_t cmd_id);
+
+/**
+ * @brief Dispatches a raw command frame (payload[0] = Command ID).
+ * Length is checked against the table entry before the handler runs.
+ */
 void COMMS_DispatchCommand(comms_frame_t *frame);
 
+/**
+ * @brief Dispatches the app data of an already validated telecommand.
+ * @return 1 if a handler ran, 0 if the command was rejected.
+ */
+int COMMS_DispatchTelecommand(const CCSDS_TcView_t *view);
+
+/**
+ * @brief Frames one housekeeping sample (HK_Pack, HK_PACKED_BYTES of
+ * payload); decode it with HK_Unpack.
+ */
 void COMMS_GenerateTelemetry(comms_frame_t *out_frame);
 
 void COMMS_ResetParser(void);
@@ -0,0 +1,72 @@
+#ifndef COMMS_PROBE_H
+#define COMMS_PROBE_H
+
+#include <stdint.h>
+#include "ccsds_packet.h"
+
+/**
+ * @brief Per-stage latency probes on the uplink command path.
+ *
+ * Build with -DCOMMS_PROBES to enable. Each PROBE_MARK reads the CPU cycle
+ * counter and adds the cycles since the previous mark of the same frame to
+ * that stage's log2 histogram (bucket b counts deltas in [2^(b-1), 2^b)).
+ * PROBE_TOTAL is sync found -> routed, i.e. first byte to router entry.
+ * Without COMMS_PROBES every PROBE_MARK compiles to nothing and the
+ * functions below are not built either.
+ *
+ * Every mark is taken by the parser itself, in whatever context runs
+ * COMMS_ParseByte, so the histograms are not locked. HANDLER_DONE is taken
+ * when the route hand-off returns: with direct routing that covers the
+ * router and the command handler of that frame; with the RX queue or RX
+ * pipeline installed it covers the enqueue only. Commands dispatched any
+ * other way (scheduler releases, COMMS_DispatchCommand, queue workers) are
+ * not sampled.
+ */
+
+typedef enum {
+    PROBE_SYNC_FOUND = 0,   // Start byte accepted (origin, count only)
+    PROBE_LENGTH_OK,        // Length byte accepted
+    PROBE_PAYLOAD_DONE,     // Last payload byte stored
+    PROBE_CRC_DONE,         // CRC computed and compared
+    PROBE_ROUTED,           // Filters passed, about to call the router
+    PROBE_HANDLER_DONE,     // Route hand-off returned (handler included when routing is direct)
+    PROBE_TOTAL,            // Sync found -> routed
+    PROBE_NUM_STAGES
+} probe_stage_t;
+
+#define PROBE_BUCKETS        32
+#define PROBE_WINDOW         16    // Buckets carried per telemetry packet
+#define PROBE_PACKET_BYTES   (2 + 4 + 4 + 2 * PROBE_WINDOW)
+#define PROBE_APID           APID_FDIR
+
+typedef struct {
+    uint32_t count;
+    uint32_t max_cycles;
+    uint32_t buckets[PROBE_BUCKETS];
+} probe_hist_t;
+
+#ifdef COMMS_PROBES
+#define PROBE_MARK(stage) PROBE_Mark(stage)
+#else
+#define PROBE_MARK(stage) ((void)0)
+#endif
+
+void PROBE_Mark(probe_stage_t stage);
+void PROBE_Reset(void);
+void PROBE_GetHistogram(probe_stage_t stage, probe_hist_t *out);
+
+/**
+ * @brief Serialises one stage: [stage][first bucket][count BE32][max BE32]
+ * then PROBE_WINDOW saturated BE16 bucket counts starting at the first
+ * non-empty bucket (anything above the window folds into its last bucket).
+ * @return PROBE_PACKET_BYTES.
+ */
+uint16_t PROBE_Encode(probe_stage_t stage, uint8_t *out);
+
+/**
+ * @brief Sends one PROBE_APID packet per stage that has samples.
+ * @return Packets committed, or -1 if a buffer could not be reserved.
+ */
+int PROBE_SendPackets(void);
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef CYCLE_COUNTER_H
+#define CYCLE_COUNTER_H
+
+#include <stdint.h>
+
+/**
+ * @brief Free-running 32-bit cycle counter for latency and WCET measurement.
+ *
+ * CCOUNT on Xtensa, esp_cpu_get_cycle_count() on other ESP targets, the
+ * TSC on x86 hosts and nanoseconds from clock_gettime elsewhere. Take
+ * differences with unsigned subtraction; they are wrap-safe for intervals
+ * under 2^32 ticks.
+ */
+
+#if defined(__XTENSA__)
+static inline uint32_t CYCLES_Now(void) {
+    uint32_t ccount;
+    __asm__ __volatile__("rsr %0, ccount" : "=a"(ccount));
+    return ccount;
+}
+#elif defined(ESP_PLATFORM)
+#include "esp_cpu.h"
+static inline uint32_t CYCLES_Now(void) { return (uint32_t)esp_cpu_get_cycle_count(); }
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint32_t CYCLES_Now(void) { return (uint32_t)__rdtsc(); }
+#else
+#include <time.h>
+static inline uint32_t CYCLES_Now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+#endif
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef DOWNLINK_SHAPER_H
+#define DOWNLINK_SHAPER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Downlink scheduler: per-APID token buckets + weighted fair queueing.
+ *
+ * Producers submit CCSDS packets; the radio calls DLS_Service() whenever it
+ * can take more bytes. Packets within their flow's rate/burst are always
+ * served first (WFQ across flows by weight), so housekeeping keeps its
+ * guaranteed bandwidth however hard a payload APID pushes. Flows with the
+ * BORROW policy may then use whatever link capacity is left over.
+ */
+
+#define DLS_MAX_FLOWS   8     // Configured flows; flow 0 is the default for unconfigured APIDs
+#define DLS_FLOW_DEPTH  8     // Packets queued per flow
+
+typedef enum {
+    DLS_POLICY_DROP = 0,   // Police: packets that do not fit the bucket are dropped on submit
+    DLS_POLICY_DEFER,      // Shape: queue until tokens are available
+    DLS_POLICY_BORROW      // Shape, but send early when the link would otherwise idle
+} dls_policy_t;
+
+typedef struct {
+    uint32_t rate_bps;     // Sustained rate, bytes per second
+    uint32_t burst;        // Bucket depth, bytes
+    uint8_t weight;        // WFQ share among conformant flows (>= 1)
+    dls_policy_t policy;
+} dls_flow_config_t;
+
+typedef struct {
+    uint32_t sent_packets;
+    uint32_t sent_bytes;
+    uint32_t borrowed_bytes;   // Sent above the flow's rate on idle link capacity
+    uint32_t dropped;          // Policed or queue full
+    uint8_t queued;
+} dls_flow_stats_t;
+
+// Transmit hook (e.g. frame + radio). Must consume the packet before returning.
+typedef void (*dls_sink_fn)(const uint8_t *packet, uint16_t len);
+
+/**
+ * @brief Resets all flows. The default flow (unconfigured APIDs) gets
+ * default_cfg.
+ */
+void DLS_Init(const dls_flow_config_t *default_cfg, dls_sink_fn sink);
+
+/**
+ * @brief Gives apid its own flow (bucket full at start). Calling it again
+ * for the same APID changes rate, burst, weight and policy in place; packets
+ * already queued on the flow stay queued. Unless the policy is BORROW, a
+ * new burst smaller than a packet already queued is refused.
+ * @return 0 on success, -1 if all flows are taken or the config is invalid.
+ */
+int DLS_ConfigureAPID(uint16_t apid, const dls_flow_config_t *cfg);
+
+/**
+ * @brief Queues a packet for downlink (copied into a frame_pool block).
+ * Outside BORROW flows, a packet longer than the flow's burst is dropped:
+ * its bucket could never hold enough tokens to send it.
+ * @return 0 if queued, -1 if dropped.
+ */
+int DLS_Submit(const uint8_t *packet, uint16_t len);
+
+/**
+ * @brief Sends queued packets whose total size fits link_budget bytes.
+ * @return Bytes handed to the sink.
+ */
+uint32_t DLS_Service(uint32_t link_budget);
+
+void DLS_GetFlowStats(uint16_t apid, dls_flow_stats_t *out);
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef FRAME_POOL_H
+#define FRAME_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "comms_frame.h"
+
+/**
+ * @brief Statically sized, fixed-block buffer pool for every comms path.
+ *
+ * Each size class keeps a lock-free free list whose head packs a 16-bit
+ * ABA tag with a 16-bit block index, so FPOOL_Alloc/FPOOL_Free are a single
+ * CAS loop and safe from both ISR and task context (no locks, no malloc).
+ * The pool needs no initialisation: zeroed static storage is a full free list.
+ */
+
+typedef enum {
+    FPOOL_CLASS_SMALL = 0,   // Short commands / descriptors
+    FPOOL_CLASS_FRAME,       // One comms_frame_t (RX/TX frames, routed packets)
+    FPOOL_CLASS_LARGE,       // Reassembly, file chunks
+    FPOOL_NUM_CLASSES
+} fpool_class_t;
+
+#define FPOOL_SMALL_BLOCK  32
+#define FPOOL_FRAME_BLOCK  ((sizeof(comms_frame_t) + 31u) & ~31u)
+#define FPOOL_LARGE_BLOCK  512
+
+#define FPOOL_SMALL_COUNT  16
+#define FPOOL_FRAME_COUNT  32
+#define FPOOL_LARGE_COUNT  4
+
+typedef struct {
+    uint32_t block_size;
+    uint32_t total;
+    uint32_t in_use;
+    uint32_t high_water;   // Max blocks ever in use at once
+    uint32_t failures;     // Allocations refused because the class was empty
+    uint32_t bad_frees;    // Frees of blocks that were not allocated (ignored)
+} fpool_stats_t;
+
+/**
+ * @brief Takes a block from the smallest class that fits size.
+ * Falls back to a larger class if the best one is empty.
+ * @return Block pointer (8-byte aligned) or NULL if nothing fits.
+ */
+void* FPOOL_Alloc(size_t size);
+
+/**
+ * @brief Returns a block to its class. Ignores NULL, foreign pointers and
+ * blocks that are already free (counted in bad_frees).
+ */
+void FPOOL_Free(void *block);
+
+/**
+ * @brief Usable size of a pool block (0 for foreign pointers).
+ */
+size_t FPOOL_BlockSize(const void *block);
+
+void FPOOL_GetStats(fpool_class_t cls, fpool_stats_t *out);
+
+/**
+ * @brief Forgets every outstanding block. Test/boot use only.
+ */
+void FPOOL_Reset(void);
+
+#endif
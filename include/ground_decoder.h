@@ -0,0 +1,60 @@
+#ifndef GROUND_DECODER_H
+#define GROUND_DECODER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Parallel ground-side decoder for recorded pass captures (host only).
+ *
+ * The capture is memory-mapped and decoded in windows of up to
+ * threads * GDEC_CHUNK_BYTES. Each window is cut into one chunk per worker,
+ * each boundary moved forward to the next FRAME_START_BYTE. Workers scan
+ * their chunk independently; a frame may run past the end of its chunk
+ * since the whole file is mapped. The merge pass then walks the chunks in
+ * stream order: where the previous chunk's last frame ran into this one,
+ * the worker started out of step, so frames are rescanned from the true
+ * resume point until they line up with the worker's list again (usually at
+ * the next frame). A window is emitted before the next one is scanned, so
+ * the frame lists stay bounded by the window, not the capture. The result
+ * is identical to a single-threaded scan.
+ *
+ * Scan rule: a frame is FRAME_START_BYTE, a length of 1..MAX_PAYLOAD_SIZE,
+ * the payload and a matching CRC-16. On a match the scan continues after
+ * the frame, otherwise at the next byte.
+ */
+
+#define GDEC_MAX_THREADS 64
+#define GDEC_CHUNK_BYTES (1u << 20)   // Per worker, per window
+
+typedef struct {
+    uint64_t offset;    // Position of the start byte in the capture
+    uint16_t apid;      // CCSDS_GetAPID of the payload (0 if shorter than 2 bytes)
+    uint8_t length;     // Payload length
+} gdec_frame_t;
+
+// Called once per frame, in stream order, from the calling thread
+typedef void (*gdec_sink_fn)(void *ctx, const gdec_frame_t *frame, const uint8_t *payload);
+
+typedef struct {
+    uint64_t bytes;
+    uint64_t frames;
+    uint64_t resyncs;   // Frames dropped or rescanned while stitching chunks
+    uint32_t threads;
+} gdec_stats_t;
+
+/**
+ * @brief Decodes an in-memory capture on `threads` workers (1..GDEC_MAX_THREADS).
+ * @return 0 on success, -1 on bad arguments or out of memory.
+ */
+int GDEC_DecodeBuffer(const uint8_t *buf, size_t size, unsigned threads,
+                      gdec_sink_fn sink, void *ctx, gdec_stats_t *stats);
+
+/**
+ * @brief mmaps a capture file read-only and decodes it with GDEC_DecodeBuffer.
+ * @return 0 on success, -1 if the file cannot be opened or mapped.
+ */
+int GDEC_DecodeFile(const char *path, unsigned threads,
+                    gdec_sink_fn sink, void *ctx, gdec_stats_t *stats);
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef HK_DELTA_H
+#define HK_DELTA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hk_schema.h"
+
+/**
+ * @brief Changed-only housekeeping encoding on top of HK_SCHEMA.
+ *
+ * Byte 0 is [keyframe:1][cycle:7]. A keyframe carries the full HK_Pack
+ * layout. In between, a delta packet carries a 2-bit code per field
+ * (unchanged / small signed delta / full value) followed by only the
+ * changed fields, bit-packed. The 7-bit cycle counter lets the ground
+ * notice a lost packet and wait for the next keyframe.
+ *
+ * These packets go out on APID_HK_DELTA, apart from the full HK_Pack frames
+ * on APID_HK: a delta can be exactly HK_PACKED_BYTES long, so the length
+ * alone cannot tell the two formats apart.
+ */
+
+#define HK_DELTA_UNCHANGED 0u
+#define HK_DELTA_SMALL     1u   // Zigzag raw delta in the field's delta bits
+#define HK_DELTA_FULL      2u   // Full raw value
+                                // Code 3 is reserved: the packet is malformed
+
+#define HK_DELTA_MAX_BYTES (1 + (2 * HK_NUM_FIELDS + HK_TOTAL_BITS + 7) / 8)
+
+typedef struct {
+    uint32_t prev[HK_NUM_FIELDS];
+    uint8_t cycle;
+    uint8_t keyframe_interval;   // Full snapshot every N packets
+    uint8_t since_keyframe;
+    bool primed;
+} hk_delta_encoder_t;
+
+typedef enum {
+    HK_DELTA_OK = 0,
+    HK_DELTA_NEED_KEYFRAME,   // Missed a packet (or no keyframe yet): state unknown
+    HK_DELTA_MALFORMED        // Truncated or reserved code: sync dropped as for a missed packet
+} hk_delta_status_t;
+
+typedef struct {
+    uint32_t state[HK_NUM_FIELDS];
+    uint8_t expected_cycle;
+    bool synced;
+    uint32_t missed;          // Gaps detected in the cycle counter
+} hk_delta_decoder_t;
+
+void HK_DeltaEncoderInit(hk_delta_encoder_t *enc, uint8_t keyframe_interval);
+
+/**
+ * @brief Encodes one HK cycle from raw field values (see HK_SampleRaw).
+ * @return Bytes written to out (at most HK_DELTA_MAX_BYTES).
+ */
+uint16_t HK_DeltaEncode(hk_delta_encoder_t *enc, const uint32_t raw[HK_NUM_FIELDS], uint8_t *out);
+
+void HK_DeltaDecoderInit(hk_delta_decoder_t *dec);
+
+/**
+ * @brief Ground side: applies one packet and, on HK_DELTA_OK, writes the
+ * rebuilt full state to out.
+ */
+hk_delta_status_t HK_DeltaDecode(hk_delta_decoder_t *dec, const uint8_t *in, uint16_t len, hk_values_t *out);
+
+/**
+ * @brief Samples the sources, encodes and commits one APID_HK_DELTA packet.
+ */
+int HK_SendDeltaPacket(hk_delta_encoder_t *enc);
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef HK_SCHEMA_H
+#define HK_SCHEMA_H
+
+#include <stdint.h>
+#include "param_db.h"
+
+/**
+ * @brief Housekeeping packet schema (single source of truth).
+ *
+ * X(NAME, source parameter, bits, scale, offset, unit, delta bits)
+ *   raw   = (value - offset) / scale, stored MSB-first in `bits` bits
+ *   value = raw * scale + offset
+ *   delta bits: width of the signed raw delta used by the changed-only
+ *   encoding for slowly varying values (0 = always resend the full value)
+ *
+ * The flight packer/unpacker and the ground decoder table are all generated
+ * from this list, so adding a parameter is a one-line change here. Each
+ * field must hold its source parameter's whole PARAM_TABLE range; this is
+ * checked at compile time in hk_schema.c.
+ */
+#define HK_SCHEMA(X) \
+    X(HEATER_STATUS,     PARAM_HEATER_STATUS,     1,  1, 0,    "bool", 0) \
+    X(THRUSTER_DURATION, PARAM_THRUSTER_DURATION, 8,  1, 0,    "s",    0) \
+    X(TARGET_TEMP,       PARAM_TARGET_TEMP,       8,  1, -128, "degC", 4) \
+    X(ALTITUDE,          PARAM_ALTITUDE,          21, 1, 0,    "m",    8)
+
+// Bit offset of every field, accumulated at compile time:
+// HK_OFF_<name> is where a field starts, HK_END_<name> its last bit
+#define HK_X_OFFSETS(name, src, bits, scale, offset, unit, dbits) \
+    HK_OFF_##name, HK_END_##name = HK_OFF_##name + (bits) - 1,
+enum { HK_SCHEMA(HK_X_OFFSETS) HK_TOTAL_BITS };
+#undef HK_X_OFFSETS
+
+#define HK_X_INDEX(name, src, bits, scale, offset, unit, dbits) HK_FIELD_##name,
+enum { HK_SCHEMA(HK_X_INDEX) HK_NUM_FIELDS };
+#undef HK_X_INDEX
+
+#define HK_PACKED_BYTES ((HK_TOTAL_BITS + 7) / 8)
+
+// Decoded engineering values, one member per schema entry
+#define HK_X_MEMBER(name, src, bits, scale, offset, unit, dbits) int32_t name;
+typedef struct {
+    HK_SCHEMA(HK_X_MEMBER)
+} hk_values_t;
+#undef HK_X_MEMBER
+
+// Ground-side decoder table entry
+typedef struct {
+    const char *name;
+    const char *unit;
+    uint16_t bit_offset;
+    uint8_t bits;
+    uint8_t delta_bits;
+    int32_t scale;
+    int32_t offset;
+} hk_field_desc_t;
+
+extern const hk_field_desc_t HK_FIELDS[HK_NUM_FIELDS];
+
+/**
+ * @brief Takes one parameter snapshot and bit-packs it into out
+ * (HK_PACKED_BYTES bytes), so all fields come from the same instant.
+ */
+void HK_Pack(uint8_t *out);
+
+/**
+ * @brief One parameter snapshot as raw (offset/scaled) field values.
+ */
+void HK_SampleRaw(uint32_t raw[HK_NUM_FIELDS]);
+
+/**
+ * @brief Converts raw field values to engineering values.
+ */
+void HK_RawToValues(const uint32_t raw[HK_NUM_FIELDS], hk_values_t *out);
+
+/**
+ * @brief Inverse of HK_Pack into engineering values.
+ */
+void HK_Unpack(const uint8_t *in, hk_values_t *out);
+
+/**
+ * @brief Table-driven decode of one field (ground tools).
+ */
+int32_t HK_DecodeField(const uint8_t *in, int field);
+
+/**
+ * @brief Packs the current state straight into a reserved APID_HK packet
+ * and commits it. @return 0 on success, -1 if no buffer was available.
+ */
+int HK_SendPacket(void);
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef MISSION_COMMANDS_H
+#define MISSION_COMMANDS_H
+
+/**
+ * @brief Registers the mission command handlers (orbit, thermal, ...)
+ * with the comms dispatcher. Call once at boot before uplink is enabled.
+ */
+void MISSION_RegisterCommands(void);
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef PACKET_BUS_H
+#define PACKET_BUS_H
+
+#include <stdint.h>
+#include "comms_frame.h"
+#include "ccsds_packet.h"
+
+#define PBUS_MAX_SUBSCRIBERS 16
+#define PBUS_APID_ANY        0xFFFF  // Wildcard subscription (every APID)
+
+/**
+ * @brief Reference-counted packet shared by all subscribers, held in one
+ * frame_pool block (header followed by the packet bytes).
+ * Subscribers must treat data[] as read-only.
+ */
+typedef struct {
+    uint16_t len;
+    uint16_t apid;
+    uint32_t refcount;
+    uint8_t data[];
+} pbus_buffer_t;
+
+/**
+ * @brief Subscriber callback. The subscriber owns one reference and must
+ * call PBUS_Release() when done, either inside the callback or later.
+ */
+typedef void (*pbus_subscriber_fn)(pbus_buffer_t *buf, void *ctx);
+
+/**
+ * @brief Clears all subscriptions and the in-use count. Boot/test use:
+ * no subscriber may still hold a buffer.
+ */
+void PBUS_Init(void);
+
+/**
+ * @brief Subscribes to one APID, or to all of them with PBUS_APID_ANY.
+ * The registry is configured at boot; it is not safe to change it while
+ * packets are being published.
+ * @return Subscription ID (>= 0) or -1 if the registry is full.
+ */
+int PBUS_Subscribe(uint16_t apid, pbus_subscriber_fn fn, void *ctx);
+void PBUS_Unsubscribe(int sub_id);
+
+/**
+ * @brief Copies the packet once into a pooled buffer and hands a reference
+ * to every matching subscriber.
+ * @return Number of subscribers reached, or -1 if the frame pool is exhausted.
+ */
+int PBUS_Publish(const uint8_t *packet, uint16_t len);
+
+/**
+ * @brief comms_route_fn_t adapter so the parser can publish directly.
+ */
+void PBUS_RouteHandler(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view);
+
+void PBUS_Retain(pbus_buffer_t *buf);
+void PBUS_Release(pbus_buffer_t *buf);
+
+// Buffers currently held by at least one subscriber
+int PBUS_BuffersInUse(void);
+
+#endif
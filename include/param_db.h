@@ -0,0 +1,95 @@
+#ifndef PARAM_DB_H
+#define PARAM_DB_H
+
+#include <stdint.h>
+
+/**
+ * @brief Spacecraft parameter database.
+ *
+ * X(NAME, type, min, max, default). Every parameter is stored as an int32_t
+ * and addressed by PARAM_<NAME>. Writers are serialised by a sequence lock;
+ * readers take no lock and retry instead, so PARAM_Snapshot always returns a
+ * set of values that existed together at one instant, even while a command
+ * handler is halfway through a multi-field update.
+ *
+ * Readers and writers must run in task context, never from an ISR. A
+ * waiter spins a bounded number of times, then sleeps a tick (yields on
+ * the host), so a preempted writer on the same core gets to finish its
+ * section whatever the two tasks' priorities.
+ */
+#define PARAM_TABLE(X) \
+    X(THRUSTER_DURATION, PARAM_TYPE_U8,  0,    255,     0)      /* Last burn (s) */ \
+    X(TARGET_TEMP,       PARAM_TYPE_I8,  -128, 127,     20)     /* Target heat (degC) */ \
+    X(HEATER_STATUS,     PARAM_TYPE_BOOL, 0,   1,       0)      /* 0 = OFF, 1 = ON */ \
+    X(ALTITUDE,          PARAM_TYPE_U32, 0,    2000000, 500000) /* Altitude (m) */
+
+typedef enum {
+    PARAM_TYPE_BOOL = 0,
+    PARAM_TYPE_U8,
+    PARAM_TYPE_I8,
+    PARAM_TYPE_U32
+} param_type_t;
+
+#define PARAM_X_ID(name, type, min, max, def) PARAM_##name,
+typedef enum { PARAM_TABLE(PARAM_X_ID) PARAM_COUNT } param_id_t;
+#undef PARAM_X_ID
+
+// PARAM_<NAME>_MIN / _MAX as constants, for compile-time checks elsewhere
+#define PARAM_X_LIMITS(name, type, min, max, def) PARAM_##name##_MIN = (min), PARAM_##name##_MAX = (max),
+enum { PARAM_TABLE(PARAM_X_LIMITS) };
+#undef PARAM_X_LIMITS
+
+typedef struct {
+    const char *name;
+    param_type_t type;
+    int32_t min;
+    int32_t max;
+    int32_t def;
+} param_info_t;
+
+extern const param_info_t PARAM_INFO[PARAM_COUNT];
+
+typedef struct {
+    int32_t v[PARAM_COUNT];
+    uint32_t version;   // Number of completed write sections so far
+} param_snapshot_t;
+
+/**
+ * @brief Restores every parameter to its default (not thread-safe).
+ */
+void PARAM_ResetDefaults(void);
+
+/**
+ * @brief Single-parameter read (one atomic load, never torn).
+ */
+int32_t PARAM_Get(param_id_t id);
+
+/**
+ * @brief Consistent copy of the whole database in one pass.
+ */
+void PARAM_Snapshot(param_snapshot_t *out);
+
+/**
+ * @brief Opens an exclusive write section. Snapshot readers retry until
+ * the matching PARAM_WriteEnd, so related fields change together.
+ */
+void PARAM_WriteBegin(void);
+void PARAM_WriteEnd(void);
+
+/**
+ * @brief Writes one value; only valid between PARAM_WriteBegin/End.
+ * @return 0 on success, -1 if id or value is out of range (nothing written).
+ */
+int PARAM_Store(param_id_t id, int32_t value);
+
+/**
+ * @brief PARAM_Store wrapped in its own write section.
+ */
+int PARAM_Set(param_id_t id, int32_t value);
+
+/**
+ * @brief Times a snapshot reader had to retry because of a concurrent write.
+ */
+uint32_t PARAM_GetRetryCount(void);
+
+#endif
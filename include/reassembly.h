@@ -0,0 +1,80 @@
+#ifndef REASSEMBLY_H
+#define REASSEMBLY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ccsds_packet.h"
+
+/**
+ * @brief Reassembly of segmented CCSDS packets (sequence flags FIRST /
+ * CONTINUATION / LAST) into one contiguous buffer.
+ *
+ * A fixed pool of REASM_SLOTS slots, each bound to one APID while a packet
+ * is in progress, so up to REASM_SLOTS APIDs can reassemble concurrently.
+ * Every segment's app data is written once, straight to its final offset in
+ * the slot's buffer; the finished packet is handed to the sink in place.
+ * Segments must arrive with consecutive sequence counts; a gap, a restart
+ * or a stale slot (no segment for the timeout) discards the partial packet.
+ * Not reentrant: call from a single task (the RX dispatch path).
+ */
+
+#define REASM_SLOTS           4
+#define REASM_MAX_SIZE        4096   // Largest reassembled app data
+#define REASM_DEFAULT_TIMEOUT 5000   // ms without a segment before a slot is dropped
+
+typedef enum {
+    REASM_PASSTHROUGH = 0,   // Unsegmented: not ours, route it normally
+    REASM_PENDING,           // Segment stored, packet not complete yet
+    REASM_COMPLETE,          // LAST segment stored, sink has been called
+    REASM_DROPPED            // Segment rejected (see stats)
+} reasm_result_t;
+
+/**
+ * @brief Receives a completed packet. data points into the slot buffer and
+ * is valid until the sink returns.
+ */
+typedef void (*reasm_sink_fn)(uint16_t apid, const uint8_t *data, uint32_t len, void *ctx);
+
+typedef struct {
+    uint32_t completed;
+    uint32_t segments;     // Segments stored
+    uint32_t orphans;      // CONTINUATION/LAST with no packet in progress
+    uint32_t gaps;         // Sequence count jumped: partial packet discarded
+    uint32_t restarts;     // FIRST arrived while a packet was in progress
+    uint32_t overflows;    // Packet grew past REASM_MAX_SIZE
+    uint32_t no_slot;      // FIRST arrived with every slot busy
+    uint32_t timeouts;
+} reasm_stats_t;
+
+/**
+ * @brief Frees every slot, clears stats, restores the default timeout.
+ */
+void REASM_Init(void);
+
+void REASM_SetSink(reasm_sink_fn sink, void *ctx);
+void REASM_SetTimeout(uint32_t timeout_ms);
+
+/**
+ * @brief Feeds one validated packet (view from CCSDS_ValidateTelecommand or
+ * the parser's route hook). Expires stale slots first.
+ */
+reasm_result_t REASM_Submit(const CCSDS_TcView_t *view);
+
+/**
+ * @brief comms_route_fn_t adapter: segments are reassembled, unsegmented
+ * packets go on to CDHS_RoutePacket unchanged.
+ */
+void REASM_RouteHandler(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view);
+
+/**
+ * @brief Drops every slot idle for longer than the timeout.
+ * @return Number of slots expired.
+ */
+int REASM_Tick(void);
+
+// Slots currently holding a packet in progress
+int REASM_ActiveSlots(void);
+
+void REASM_GetStats(reasm_stats_t *out);
+
+#endif
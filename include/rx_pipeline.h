@@ -0,0 +1,82 @@
+#ifndef RX_PIPELINE_H
+#define RX_PIPELINE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "comms_frame.h"
+
+/**
+ * @brief Two-stage receive pipeline: ingest/deframe on one core, route and
+ * dispatch on the other.
+ *
+ *   radio driver --RXP_Receive--> [byte ring] --> stage 1: COMMS_ParseByte
+ *     (sync, length, CRC, APID filter, CCSDS checks, replay window)
+ *   stage 1 --validated packet descriptor--> [frame ring] --> stage 2: dispatch
+ *
+ * Both rings are bounded single-producer/single-consumer queues driven by
+ * atomic head/tail indices only, so neither side ever takes a lock. Packet
+ * bytes travel in frame_pool blocks; the descriptor passes ownership.
+ * A slow handler only fills the frame ring (excess packets are dropped and
+ * counted), it never stalls the parser.
+ *
+ * Stage 1 is the parser's only caller while the pipeline runs. RXP_Receive
+ * has a single producer (the UART/radio task, not an ISR).
+ */
+
+#define RXP_BYTE_RING    4096   // Raw bytes between the radio and stage 1 (power of 2)
+#define RXP_FRAME_DEPTH  16     // Validated packets between stage 1 and stage 2 (power of 2)
+#define RXP_CORE_ANY     (-1)   // No affinity
+
+typedef struct {
+    int ingest_core;            // Core for stage 1, or RXP_CORE_ANY
+    int dispatch_core;          // Core for stage 2, or RXP_CORE_ANY
+    comms_route_fn_t dispatch;  // Stage 2 handler; NULL routes through CDHS_RoutePacket
+} rxp_config_t;
+
+typedef struct {
+    uint32_t bytes_in;          // Accepted by RXP_Receive
+    uint32_t bytes_dropped;     // Byte ring full
+    uint32_t frames_queued;
+    uint32_t frames_dropped;    // Frame ring full or frame pool empty
+    uint32_t frames_dispatched;
+    uint32_t frame_high_water;  // Deepest the frame ring has been
+} rxp_stats_t;
+
+/**
+ * @brief Core 0 ingests, core 1 dispatches, CDHS router as the handler.
+ */
+void RXP_DefaultConfig(rxp_config_t *cfg);
+
+/**
+ * @brief Empties both rings, installs the stage 1 hand-off as the parser's
+ * route handler and starts the two stages (FreeRTOS tasks pinned with
+ * xTaskCreatePinnedToCore on target, pthreads with best-effort affinity on host).
+ * @param cfg NULL for RXP_DefaultConfig.
+ * @return 0 on success, -1 if a stage could not be started.
+ */
+int RXP_Start(const rxp_config_t *cfg);
+
+/**
+ * @brief Stops both stages, frees anything still queued and restores the
+ * parser's default route handler. Queued packets that were never dispatched
+ * have their sequence counts released, so the ground can resend them.
+ */
+void RXP_Stop(void);
+
+/**
+ * @brief Queues raw radio bytes for stage 1 (never blocks).
+ * @return Bytes accepted; the rest did not fit and are counted as dropped.
+ */
+size_t RXP_Receive(const uint8_t *data, size_t len);
+
+/**
+ * @brief Waits until every received byte is parsed and every queued packet
+ * dispatched.
+ * @return true if the pipeline went idle within timeout_ms.
+ */
+bool RXP_WaitIdle(uint32_t timeout_ms);
+
+void RXP_GetStats(rxp_stats_t *out);
+
+#endif
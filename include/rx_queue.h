@@ -0,0 +1,86 @@
+#ifndef RX_QUEUE_H
+#define RX_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "comms_frame.h"
+#include "ccsds_packet.h"
+
+// Routing priorities, highest first. Workers always drain a higher
+// priority queue completely before looking at a lower one.
+typedef enum {
+    RXQ_PRIO_SAFETY = 0,   // FDIR, CDHS commands
+    RXQ_PRIO_ADCS,
+    RXQ_PRIO_EPS,          // EPS, Housekeeping
+    RXQ_PRIO_PAYLOAD,      // Payload, Archive and anything unmapped
+    RXQ_NUM_PRIORITIES
+} rxq_priority_t;
+
+#define RXQ_DEPTH 8   // Packets per priority queue
+
+/**
+ * @brief One queued packet. data is a frame_pool block owned by whoever
+ * holds the descriptor; the view's app_data points into it.
+ */
+typedef struct {
+    uint8_t *data;
+    uint16_t len;
+    CCSDS_TcView_t view;
+} rxq_packet_t;
+
+typedef struct {
+    uint32_t enqueued[RXQ_NUM_PRIORITIES];
+    uint32_t dropped[RXQ_NUM_PRIORITIES];      // Queue full or frame pool empty
+    uint8_t high_water[RXQ_NUM_PRIORITIES];
+} rxq_stats_t;
+
+/**
+ * @brief Empties the queues, loads the default APID priority map and
+ * installs RXQ_Enqueue as the parser's route hand-off.
+ */
+void RXQ_Init(void);
+
+void RXQ_SetPriority(uint16_t apid, rxq_priority_t prio);
+rxq_priority_t RXQ_GetPriority(uint16_t apid);
+
+/**
+ * @brief Copies a validated packet into a frame_pool block and queues it
+ * by priority (never blocks; safe to call from the radio ISR on target).
+ * Matches comms_route_fn_t so it can be installed with COMMS_SetRouteHandler.
+ */
+void RXQ_Enqueue(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view);
+
+/**
+ * @brief Pops the oldest packet of the highest non-empty priority.
+ * Ownership of out->data passes to the caller; hand it back with RXQ_Release.
+ * @return true if a packet was dequeued.
+ */
+bool RXQ_Dequeue(rxq_packet_t *out);
+
+void RXQ_Release(rxq_packet_t *pkt);
+
+/**
+ * @brief Routes every queued packet in strict priority order on the
+ * caller's thread. Returns the number of packets routed.
+ */
+int RXQ_ProcessPending(void);
+
+/**
+ * @brief Starts/stops the worker task that blocks on the queues and calls
+ * CDHS_RoutePacket (pthread on host, FreeRTOS task on target).
+ * RXQ_StopWorker returns once the worker has exited, so it must not be
+ * called from a route handler.
+ * @return 0 on success, -1 if the worker could not be started.
+ */
+int RXQ_StartWorker(void);
+void RXQ_StopWorker(void);
+
+/**
+ * @brief View of the packet the worker is routing right now.
+ * Valid only inside CDHS_RoutePacket when called from the worker.
+ */
+const CCSDS_TcView_t* RXQ_GetCurrentTelecommand(void);
+
+void RXQ_GetStats(rxq_stats_t *out);
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef TM_ARCHIVE_H
+#define TM_ARCHIVE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Store-and-forward telemetry archive on an append-only circular log.
+ *
+ * The log is split into erase sectors; records never straddle a sector, so
+ * wrapping only ever drops the oldest whole sector. Each sector carries a
+ * sequence number (to find the oldest one after reboot) and a RAM index
+ * entry with its MET range and an APID bloom mask. A query skips sectors
+ * that cannot match and reads the rest front to back, straight out of the
+ * memory-mapped log. If a torn append left programmed bytes after the last
+ * record, mount closes that sector and appends continue in the next one.
+ *
+ * Backing store: a flash partition on target, a memory-mapped file on host
+ * (programmed with the same bit-clearing semantics).
+ */
+
+#define ARCH_SECTOR_SIZE   4096
+#define ARCH_MAX_SECTORS   256
+#define ARCH_APID_ANY      0xFFFF
+
+// Receives archived packets during a dump (e.g. DLS_Submit or the framer)
+typedef void (*arch_sink_fn)(const uint8_t *packet, uint16_t len);
+
+/**
+ * @brief Resumable dump position, so a pass can be served in slices.
+ */
+typedef struct {
+    uint16_t apid;         // ARCH_APID_ANY for every APID
+    uint64_t t0_ms;
+    uint64_t t1_ms;        // Inclusive
+    uint32_t sector_seq;   // Sector being read (sequence number, survives wrap)
+    uint32_t offset;       // Next record inside that sector (0 = start)
+    bool done;
+} arch_cursor_t;
+
+#ifdef ESP_PLATFORM
+/**
+ * @brief Opens the archive on a data partition (label from the partition table).
+ */
+int ARCH_OpenPartition(const char *label);
+#else
+/**
+ * @brief Opens (or creates) a host archive file of size bytes and mmaps it.
+ * Existing records are re-indexed.
+ */
+int ARCH_OpenFile(const char *path, uint32_t size);
+#endif
+
+void ARCH_Close(void);
+
+/**
+ * @brief Appends one CCSDS packet. MET and APID are taken from its headers
+ * (current MET if it has no Secondary Header).
+ * @return 0 on success, -1 if the archive is closed or the packet invalid.
+ */
+int ARCH_Store(const uint8_t *packet, uint16_t len);
+
+/**
+ * @brief Starts a query for apid between t0_ms and t1_ms (inclusive).
+ */
+void ARCH_DumpBegin(arch_cursor_t *cursor, uint16_t apid, uint64_t t0_ms, uint64_t t1_ms);
+
+/**
+ * @brief Streams up to max_packets matching packets, oldest first.
+ * @return Number of packets handed to sink (0 once the query is exhausted).
+ */
+int ARCH_DumpNext(arch_cursor_t *cursor, arch_sink_fn sink, int max_packets);
+
+uint32_t ARCH_RecordCount(void);
+
+#endif
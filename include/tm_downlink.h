@@ -0,0 +1,63 @@
+#ifndef TM_DOWNLINK_H
+#define TM_DOWNLINK_H
+
+#include <stdint.h>
+#include "comms_frame.h"
+#include "ccsds_packet.h"
+
+/**
+ * @brief Zero-copy telemetry producer API.
+ *
+ * TM_Reserve hands out a pointer into the final on-wire frame buffer
+ * (a frame_pool block laid out as [Start][Length][CCSDS headers][app data][CRC]),
+ * just past the pre-built headers. The producer writes its fields in place;
+ * TM_Commit stamps MET, sequence count and CRC and passes the finished frame
+ * to the downlink sink without any copy.
+ */
+
+// App data that still fits one comms frame
+#define TM_MAX_APP_DATA (MAX_PAYLOAD_SIZE - CCSDS_HEADERS_SIZE)
+
+/**
+ * @brief Receives committed wire frames. The sink owns the buffer and must
+ * return it with TM_ReleaseFrame() once transmitted.
+ */
+typedef void (*tm_downlink_sink_fn)(uint8_t *frame, uint16_t frame_len);
+
+void TM_SetDownlinkSink(tm_downlink_sink_fn sink);
+
+/**
+ * @brief Reserves room for len bytes of app data for apid.
+ * @return Where to write the app data, or NULL (too long / pool empty).
+ */
+uint8_t* TM_Reserve(uint16_t apid, uint16_t len);
+
+/**
+ * @brief Finalises the packet whose app data starts at app_data and queues it.
+ * @return 0 on success, -1 if app_data is not an open reservation (never
+ * reserved, already committed or aborted).
+ */
+int TM_Commit(uint8_t *app_data);
+
+/**
+ * @brief Gives a reservation back without sending it. Ignored if app_data
+ * is not an open reservation.
+ */
+void TM_Abort(uint8_t *app_data);
+
+// Packets per TM_SendSegmented call (256 x 50 bytes = 12.8 KB of app data)
+#define TM_MAX_SEGMENTS 256
+
+/**
+ * @brief Sends data of any length up to TM_MAX_SEGMENTS * TM_MAX_APP_DATA.
+ * Data that fits one frame goes out unsegmented; anything longer is split
+ * into FIRST / CONTINUATION... / LAST packets with consecutive sequence
+ * counts, each frame built in place as with TM_Reserve/TM_Commit.
+ * @return Number of packets sent, or -1 (too long / frame pool ran dry,
+ * in which case the receiver discards the partial packet on timeout).
+ */
+int TM_SendSegmented(uint16_t apid, const uint8_t *data, uint32_t len);
+
+void TM_ReleaseFrame(uint8_t *frame);
+
+#endif
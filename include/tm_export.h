@@ -0,0 +1,92 @@
+#ifndef TM_EXPORT_H
+#define TM_EXPORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ground_decoder.h"
+
+/**
+ * @brief Streaming per-APID columnar export of decoded telemetry (host only).
+ *
+ * Every APID gets a directory <dir>/apid_XXX/ holding one file per column:
+ *   met.col      uint64  MET from the Secondary Header (0 if absent)
+ *   seq.col      uint16  14-bit Packet Sequence Count
+ *   len.col      uint16  App data length
+ *   payload.col  uint8   App data, back to back (row offsets = prefix sum of len)
+ * plus, for the housekeeping APIDs:
+ *   hk_valid.col uint8   1 if the row decoded, 0 if it could not be
+ *   <NAME>.col   int32   Engineering value, one column per HK_SCHEMA field
+ * The APID picks the decoder: APID_HK rows are HK_Pack frames,
+ * APID_HK_DELTA rows go through a per-stream HK_DeltaDecode. Rows that
+ * cannot be decoded (wrong length, or deltas before the first keyframe)
+ * have hk_valid 0 and hold 0 in every field column; check hk_valid before
+ * reading a field, since 0 is also a real reading.
+ *
+ * A column file is a TMX_HEADER_SIZE header followed by a plain
+ * little-endian array, so a reader can mmap one column and index it
+ * directly; the row count is (file size - header) / element size. Rows are
+ * buffered per column and written in TMX_BLOCK_SIZE blocks.
+ */
+
+#define TMX_MAX_STREAMS   16          // Distinct APIDs per export
+#define TMX_BLOCK_SIZE    (64 * 1024)
+#define TMX_HEADER_SIZE   64
+#define TMX_MAGIC         "CCOL"
+
+typedef enum {
+    TMX_TYPE_U8 = 1,
+    TMX_TYPE_U16,
+    TMX_TYPE_I32,
+    TMX_TYPE_U64
+} tmx_type_t;
+
+// On-disk column header (little-endian, padded to TMX_HEADER_SIZE)
+typedef struct {
+    char magic[4];          // TMX_MAGIC
+    uint16_t version;       // 1
+    uint8_t type;           // tmx_type_t
+    uint8_t elem_size;
+    uint16_t apid;
+    uint16_t reserved;
+    char name[32];          // Column name, NUL-terminated
+    uint8_t pad[TMX_HEADER_SIZE - 44];
+} tmx_column_header_t;
+
+typedef struct {
+    uint64_t packets;
+    uint64_t rejected;      // Short/inconsistent packets, or out of streams
+    uint64_t bytes_written;
+    uint32_t streams;
+} tmx_stats_t;
+
+/**
+ * @brief Starts an export into dir (created if missing). Appends to
+ * existing column files, so a campaign can be exported pass by pass.
+ * @return 0 on success, -1 if dir cannot be created or an export is open.
+ */
+int TMX_Open(const char *dir);
+
+/**
+ * @brief Appends one CCSDS packet (starting at the Primary Header).
+ * @return 0 on success, -1 if the packet was rejected.
+ */
+int TMX_Append(const uint8_t *packet, uint16_t len);
+
+/**
+ * @brief GDEC sink: exports every decoded frame's payload (ctx unused).
+ */
+void TMX_GdecSink(void *ctx, const gdec_frame_t *frame, const uint8_t *payload);
+
+/**
+ * @brief Writes out every buffered block.
+ */
+int TMX_Flush(void);
+
+/**
+ * @brief Flushes, closes every column file and frees the buffers.
+ */
+int TMX_Close(void);
+
+void TMX_GetStats(tmx_stats_t *out);
+
+#endif
@@ -0,0 +1,150 @@
+#include <string.h>
+#include "cfdp.h"
+#include "byte_order.h"
+
+// Fixed header byte 0: version, PDU type, direction, transmission mode, CRC flag, large file flag
+#define HDR_TYPE_FILE_DATA  0x10
+#define HDR_TOWARD_SENDER   0x08
+#define HDR_UNACKNOWLEDGED  0x04
+#define HDR_CRC_PRESENT     0x02
+#define HDR_LARGE_FILE      0x01
+
+// Fixed header byte 3: entity ID length - 1 (bits 6..4), sequence number length - 1 (bits 2..0)
+#define HDR_ID_LENGTHS      0x01   // 1-byte entity IDs, 2-byte transaction numbers
+
+uint32_t CFDP_Checksum(uint32_t sum, uint32_t offset, const uint8_t *data, size_t len) {
+    size_t i = 0;
+
+    // 1. Leading bytes up to the next word boundary of the file
+    for (; i < len && ((offset + i) & 3u) != 0; i++) {
+        sum += (uint32_t)data[i] << (8u * (3u - ((offset + i) & 3u)));
+    }
+
+    // 2. Whole aligned words
+    for (; i + 4 <= len; i += 4) {
+        sum += BE_Load32(&data[i]);
+    }
+
+    // 3. Trailing bytes (the end of the file counts as zero padding)
+    for (; i < len; i++) {
+        sum += (uint32_t)data[i] << (8u * (3u - ((offset + i) & 3u)));
+    }
+    return sum;
+}
+
+static uint8_t *encode_lv(uint8_t *p, const char *s) {
+    size_t n = strlen(s);
+    *p = (uint8_t)n;
+    memcpy(p + 1, s, n);
+    return p + 1 + n;
+}
+
+uint16_t CFDP_EncodePdu(const cfdp_pdu_t *pdu, uint8_t *out) {
+    if (pdu == NULL || out == NULL) return 0;
+    uint8_t *p = &out[CFDP_PDU_HEADER_SIZE];
+
+    // 1. Data field
+    switch (pdu->type) {
+        case CFDP_PDU_FILE_DATA:
+            if (pdu->data_len > CFDP_FILE_DATA_PER_PDU) return 0;
+            BE_Store32(p, pdu->offset);
+            memcpy(p + 4, pdu->data, pdu->data_len);
+            p += 4 + pdu->data_len;
+            break;
+
+        case CFDP_PDU_EOF:
+            p[0] = CFDP_DIR_EOF;
+            p[1] = (uint8_t)(pdu->condition << 4);
+            BE_Store32(&p[2], pdu->checksum);
+            BE_Store32(&p[6], pdu->file_size);
+            p += 10;
+            break;
+
+        case CFDP_PDU_METADATA:
+            if (strlen(pdu->source_name) > CFDP_MAX_FILENAME || strlen(pdu->dest_name) > CFDP_MAX_FILENAME) return 0;
+            p[0] = CFDP_DIR_METADATA;
+            p[1] = 0x00;   // No closure requested, modular checksum
+            BE_Store32(&p[2], pdu->file_size);
+            p = encode_lv(&p[6], pdu->source_name);
+            p = encode_lv(p, pdu->dest_name);
+            break;
+
+        default:
+            return 0;
+    }
+
+    // 2. Fixed header, now that the data field length is known
+    uint16_t data_len = (uint16_t)(p - &out[CFDP_PDU_HEADER_SIZE]);
+    out[0] = (uint8_t)((CFDP_VERSION << 5) | HDR_UNACKNOWLEDGED |
+                       (pdu->type == CFDP_PDU_FILE_DATA ? HDR_TYPE_FILE_DATA : 0));
+    BE_Store16(&out[1], data_len);
+    out[3] = HDR_ID_LENGTHS;
+    out[4] = pdu->source_id;
+    BE_Store16(&out[5], pdu->transaction);
+    out[7] = pdu->dest_id;
+    return (uint16_t)(CFDP_PDU_HEADER_SIZE + data_len);
+}
+
+static int decode_lv(const uint8_t **p, const uint8_t *end, char *out) {
+    if (*p >= end) return -1;
+    uint8_t n = **p;
+    if (n > CFDP_MAX_FILENAME || *p + 1 + n > end) return -1;
+    memcpy(out, *p + 1, n);
+    out[n] = '\0';
+    *p += 1 + n;
+    return 0;
+}
+
+int CFDP_DecodePdu(const uint8_t *pdu, uint16_t len, cfdp_pdu_t *out) {
+    if (pdu == NULL || out == NULL || len < CFDP_PDU_HEADER_SIZE) return -1;
+
+    // 1. Fixed header: only the Class 1 profile we send is accepted
+    uint8_t flags = pdu[0];
+    if ((flags >> 5) != CFDP_VERSION ||
+        (flags & (HDR_TOWARD_SENDER | HDR_CRC_PRESENT | HDR_LARGE_FILE)) != 0 ||
+        (flags & HDR_UNACKNOWLEDGED) == 0 ||
+        (pdu[3] & 0x77) != HDR_ID_LENGTHS ||
+        BE_Load16(&pdu[1]) != len - CFDP_PDU_HEADER_SIZE) {
+        return -1;
+    }
+    memset(out, 0, sizeof(*out));
+    out->source_id = pdu[4];
+    out->transaction = BE_Load16(&pdu[5]);
+    out->dest_id = pdu[7];
+
+    const uint8_t *p = &pdu[CFDP_PDU_HEADER_SIZE];
+    const uint8_t *end = pdu + len;
+
+    // 2. File Data: offset + bytes
+    if (flags & HDR_TYPE_FILE_DATA) {
+        if (end - p < 4) return -1;
+        out->type = CFDP_PDU_FILE_DATA;
+        out->offset = BE_Load32(p);
+        out->data = p + 4;
+        out->data_len = (uint16_t)(end - p - 4);
+        return 0;
+    }
+
+    // 3. File directives
+    if (end - p < 2) return -1;
+    switch (p[0]) {
+        case CFDP_DIR_EOF:
+            if (end - p < 10) return -1;
+            out->type = CFDP_PDU_EOF;
+            out->condition = p[1] >> 4;
+            out->checksum = BE_Load32(&p[2]);
+            out->file_size = BE_Load32(&p[6]);
+            return 0;
+
+        case CFDP_DIR_METADATA:
+            if (end - p < 6) return -1;
+            out->type = CFDP_PDU_METADATA;
+            out->file_size = BE_Load32(&p[2]);
+            p += 6;
+            if (decode_lv(&p, end, out->source_name) != 0) return -1;
+            return decode_lv(&p, end, out->dest_name);
+
+        default:
+            return -1;   // ACK/NAK/Finished/Prompt belong to Class 2
+    }
+}
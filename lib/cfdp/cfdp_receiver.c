@@ -0,0 +1,188 @@
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "cfdp.h"
+
+int CFDP_ReceiverInit(cfdp_receiver_t *rx, const char *dir) {
+    if (rx == NULL || dir == NULL || strlen(dir) >= sizeof(rx->dir)) return -1;
+    memset(rx, 0, sizeof(*rx));
+    strcpy(rx->dir, dir);
+    rx->fd = -1;
+    rx->state = CFDP_RX_IDLE;
+    return 0;
+}
+
+void CFDP_ReceiverClose(cfdp_receiver_t *rx) {
+    if (rx == NULL) return;
+    if (rx->fd >= 0) close(rx->fd);
+    rx->fd = -1;
+}
+
+// A dest name is a plain file name inside rx->dir, never a path
+static bool safe_name(const char *name) {
+    return name[0] != '\0' && strchr(name, '/') == NULL &&
+           strcmp(name, ".") != 0 && strcmp(name, "..") != 0;
+}
+
+static void open_transaction(cfdp_receiver_t *rx, const cfdp_pdu_t *pdu) {
+    char dir[sizeof(rx->dir)];
+
+    // 1. Forget the previous transaction (its file stays as it is on disk)
+    CFDP_ReceiverClose(rx);
+    memcpy(dir, rx->dir, sizeof(dir));
+    memset(rx, 0, sizeof(*rx));
+    memcpy(rx->dir, dir, sizeof(dir));
+    rx->source_id = pdu->source_id;
+    rx->transaction = pdu->transaction;
+    rx->file_size = pdu->file_size;
+    rx->pdus = 1;
+
+    // 2. Full-size sparse file: segments land at their offsets in any order
+    snprintf(rx->path, sizeof(rx->path), "%s/%s", rx->dir, pdu->dest_name);
+    rx->fd = open(rx->path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (rx->fd < 0 || ftruncate(rx->fd, (off_t)rx->file_size) != 0) {
+        CFDP_ReceiverClose(rx);
+        rx->state = CFDP_RX_ERROR;
+        return;
+    }
+    rx->state = CFDP_RX_RECEIVING;
+}
+
+// Merges [start, end) into the sorted, disjoint extent table
+static void track_extent(cfdp_receiver_t *rx, uint32_t start, uint32_t end) {
+    int i = 0;
+    while (i < rx->extent_count && rx->extents[i].end < start) i++;
+
+    // 1. Touches nothing: insert as a new extent
+    if (i == rx->extent_count || rx->extents[i].start > end) {
+        if (rx->extent_count == CFDP_MAX_EXTENTS) {
+            rx->untracked++;   // Written, but will still be listed as a gap
+            return;
+        }
+        memmove(&rx->extents[i + 1], &rx->extents[i], (size_t)(rx->extent_count - i) * sizeof(cfdp_extent_t));
+        rx->extents[i].start = start;
+        rx->extents[i].end = end;
+        rx->extent_count++;
+        return;
+    }
+
+    // 2. Overlaps or abuts extents i..j: collapse them into one
+    int j = i;
+    while (j + 1 < rx->extent_count && rx->extents[j + 1].start <= end) j++;
+    if (start < rx->extents[i].start) rx->extents[i].start = start;
+    rx->extents[i].end = (end > rx->extents[j].end) ? end : rx->extents[j].end;
+    memmove(&rx->extents[i + 1], &rx->extents[j + 1], (size_t)(rx->extent_count - j - 1) * sizeof(cfdp_extent_t));
+    rx->extent_count = (uint16_t)(rx->extent_count - (j - i));
+}
+
+static void add_new_bytes(cfdp_receiver_t *rx, const cfdp_pdu_t *pdu, uint32_t from, uint32_t to) {
+    rx->checksum = CFDP_Checksum(rx->checksum, from, pdu->data + (from - pdu->offset), to - from);
+    rx->bytes_received += to - from;
+}
+
+static void store_file_data(cfdp_receiver_t *rx, const cfdp_pdu_t *pdu) {
+    uint32_t start = pdu->offset;
+    uint32_t end = start + pdu->data_len;
+    if (end < start || end > rx->file_size) {
+        rx->rejected++;
+        return;
+    }
+
+    // 1. Straight to its place in the file
+    if (pwrite(rx->fd, pdu->data, pdu->data_len, (off_t)start) != (ssize_t)pdu->data_len) {
+        CFDP_ReceiverClose(rx);
+        rx->state = CFDP_RX_ERROR;
+        return;
+    }
+
+    // 2. Checksum only the bytes that fill a gap, so repeats don't count twice
+    uint32_t before = rx->bytes_received;
+    uint32_t cur = start;
+    for (int i = 0; i < rx->extent_count && cur < end; i++) {
+        const cfdp_extent_t *e = &rx->extents[i];
+        if (e->end <= cur) continue;
+        if (e->start >= end) break;
+        if (e->start > cur) add_new_bytes(rx, pdu, cur, e->start);
+        cur = e->end;
+    }
+    if (cur < end) add_new_bytes(rx, pdu, cur, end);
+    rx->duplicate_bytes += pdu->data_len - (rx->bytes_received - before);
+
+    track_extent(rx, start, end);
+}
+
+// After EOF: complete once the single extent covers the whole file
+static void evaluate(cfdp_receiver_t *rx) {
+    if (!rx->eof_seen || rx->state == CFDP_RX_ERROR) return;
+
+    bool whole = (rx->file_size == 0) ||
+                 (rx->extent_count == 1 && rx->extents[0].start == 0 && rx->extents[0].end == rx->file_size);
+    if (rx->eof_condition != CFDP_COND_NO_ERROR || !whole) {
+        rx->state = CFDP_RX_INCOMPLETE;
+    } else {
+        rx->state = (rx->checksum == rx->eof_checksum) ? CFDP_RX_COMPLETE : CFDP_RX_CHECKSUM_FAILED;
+    }
+}
+
+cfdp_rx_state_t CFDP_ReceiverPacket(cfdp_receiver_t *rx, const uint8_t *packet, uint16_t len) {
+    cfdp_pdu_t pdu;
+    if (rx == NULL) return CFDP_RX_ERROR;
+
+    // 1. Unwrap the CCSDS packet and decode the PDU it carries
+    if (packet == NULL || len <= CCSDS_HEADERS_SIZE || !CCSDS_HasSecondaryHeader(packet) ||
+        CFDP_DecodePdu(packet + CCSDS_HEADERS_SIZE, (uint16_t)(len - CCSDS_HEADERS_SIZE), &pdu) != 0) {
+        rx->rejected++;
+        return rx->state;
+    }
+
+    // 2. Metadata for a new transaction opens the next file; repeats are ignored
+    bool current = (rx->state != CFDP_RX_IDLE &&
+                    pdu.source_id == rx->source_id && pdu.transaction == rx->transaction);
+    if (pdu.type == CFDP_PDU_METADATA) {
+        if (current) {
+            rx->pdus++;
+        } else if (safe_name(pdu.dest_name)) {
+            open_transaction(rx, &pdu);
+        } else {
+            rx->rejected++;
+        }
+        return rx->state;
+    }
+
+    // 3. Everything else must belong to the open transaction
+    if (!current || rx->state == CFDP_RX_ERROR) {
+        rx->rejected++;
+        return rx->state;
+    }
+    rx->pdus++;
+
+    if (pdu.type == CFDP_PDU_FILE_DATA) {
+        store_file_data(rx, &pdu);
+    } else {
+        rx->eof_seen = true;
+        rx->eof_checksum = pdu.checksum;
+        rx->eof_condition = pdu.condition;
+        if (pdu.condition == CFDP_COND_NO_ERROR && pdu.file_size != rx->file_size) {
+            rx->eof_condition = CFDP_COND_FILE_SIZE_ERROR;
+        }
+    }
+    evaluate(rx);
+    return rx->state;
+}
+
+int CFDP_ReceiverGaps(const cfdp_receiver_t *rx, cfdp_extent_t *out, int max) {
+    if (rx == NULL || out == NULL) return 0;
+    int n = 0;
+    uint32_t cur = 0;
+    for (int i = 0; i <= rx->extent_count && n < max; i++) {
+        uint32_t next = (i < rx->extent_count) ? rx->extents[i].start : rx->file_size;
+        if (next > cur) {
+            out[n].start = cur;
+            out[n].end = next;
+            n++;
+        }
+        if (i < rx->extent_count) cur = rx->extents[i].end;
+    }
+    return n;
+}
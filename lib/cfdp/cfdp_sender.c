@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <string.h>
+#include "cfdp.h"
+
+int CFDP_ReadMemory(void *ctx, uint32_t offset, uint8_t *buf, uint32_t len) {
+    const cfdp_memory_source_t *src = ctx;
+    if (src == NULL || src->base == NULL) return -1;
+    if (offset >= src->size) return 0;
+    if (len > src->size - offset) len = src->size - offset;
+    memcpy(buf, src->base + offset, len);
+    return (int)len;
+}
+
+int CFDP_ReadFile(void *ctx, uint32_t offset, uint8_t *buf, uint32_t len) {
+    FILE *f = ctx;
+    if (f == NULL || fseek(f, (long)offset, SEEK_SET) != 0) return -1;
+    size_t got = fread(buf, 1, len, f);
+    return ferror(f) ? -1 : (int)got;
+}
+
+int CFDP_SenderStart(cfdp_sender_t *tx, const cfdp_send_config_t *cfg) {
+    if (tx == NULL || cfg == NULL || cfg->read == NULL || cfg->emit == NULL ||
+        cfg->source_name == NULL || cfg->dest_name == NULL ||
+        strlen(cfg->source_name) > CFDP_MAX_FILENAME || strlen(cfg->dest_name) > CFDP_MAX_FILENAME) {
+        return -1;
+    }
+    tx->cfg = *cfg;
+    tx->state = CFDP_TX_METADATA;
+    tx->offset = 0;
+    tx->checksum = 0;
+    tx->condition = CFDP_COND_NO_ERROR;
+    tx->pdus_sent = 0;
+    tx->chunk_offset = 0;
+    tx->chunk_len = 0;
+    return 0;
+}
+
+// Encodes one PDU, wraps it in a CCSDS packet and hands it to the link
+static void send_pdu(cfdp_sender_t *tx, cfdp_pdu_t *pdu) {
+    uint8_t buf[CFDP_MAX_PDU];
+    uint8_t packet[MAX_PAYLOAD_SIZE];
+
+    pdu->source_id = tx->cfg.source_id;
+    pdu->dest_id = tx->cfg.dest_id;
+    pdu->transaction = tx->cfg.transaction;
+
+    uint16_t len = CFDP_EncodePdu(pdu, buf);
+    CCSDS_WrapTelemetry(tx->cfg.apid, buf, len, packet);
+    tx->cfg.emit(packet, (uint16_t)(CCSDS_HEADERS_SIZE + len), tx->cfg.emit_ctx);
+    tx->pdus_sent++;
+}
+
+// Reads the next chunk once the current one is used up; false ends the transfer
+static bool refill_chunk(cfdp_sender_t *tx) {
+    if (tx->offset < tx->chunk_offset + tx->chunk_len) return true;
+
+    uint32_t want = tx->cfg.file_size - tx->offset;
+    if (want > CFDP_READ_CHUNK) want = CFDP_READ_CHUNK;
+    int got = tx->cfg.read(tx->cfg.read_ctx, tx->offset, tx->chunk, want);
+    if (got <= 0) {
+        // Unreadable, or the file is shorter than announced
+        tx->condition = (got < 0) ? CFDP_COND_FILESTORE_REJECTION : CFDP_COND_FILE_SIZE_ERROR;
+        return false;
+    }
+
+    // The checksum runs over each chunk once, as it is read
+    tx->chunk_offset = tx->offset;
+    tx->chunk_len = (uint32_t)got;
+    tx->checksum = CFDP_Checksum(tx->checksum, tx->chunk_offset, tx->chunk, tx->chunk_len);
+    return true;
+}
+
+cfdp_tx_state_t CFDP_SenderStep(cfdp_sender_t *tx, uint32_t max_pdus) {
+    if (tx == NULL) return CFDP_TX_IDLE;
+
+    for (uint32_t n = 0; n < max_pdus; n++) {
+        cfdp_pdu_t pdu;
+        memset(&pdu, 0, sizeof(pdu));
+
+        // A failed read ends the data phase early; EOF reports why
+        if (tx->state == CFDP_TX_DATA && !refill_chunk(tx)) {
+            tx->state = CFDP_TX_EOF;
+        }
+
+        switch (tx->state) {
+            case CFDP_TX_METADATA:
+                pdu.type = CFDP_PDU_METADATA;
+                pdu.file_size = tx->cfg.file_size;
+                strcpy(pdu.source_name, tx->cfg.source_name);
+                strcpy(pdu.dest_name, tx->cfg.dest_name);
+                send_pdu(tx, &pdu);
+                tx->state = (tx->cfg.file_size > 0) ? CFDP_TX_DATA : CFDP_TX_EOF;
+                break;
+
+            case CFDP_TX_DATA:
+                pdu.type = CFDP_PDU_FILE_DATA;
+                pdu.offset = tx->offset;
+                pdu.data = &tx->chunk[tx->offset - tx->chunk_offset];
+                pdu.data_len = (uint16_t)(tx->chunk_offset + tx->chunk_len - tx->offset);
+                if (pdu.data_len > CFDP_FILE_DATA_PER_PDU) pdu.data_len = CFDP_FILE_DATA_PER_PDU;
+                send_pdu(tx, &pdu);
+                tx->offset += pdu.data_len;
+                if (tx->offset >= tx->cfg.file_size) tx->state = CFDP_TX_EOF;
+                break;
+
+            case CFDP_TX_EOF:
+                pdu.type = CFDP_PDU_EOF;
+                pdu.condition = tx->condition;
+                pdu.checksum = tx->checksum;
+                pdu.file_size = (tx->condition == CFDP_COND_NO_ERROR) ? tx->cfg.file_size : tx->offset;
+                send_pdu(tx, &pdu);
+                tx->state = (tx->condition == CFDP_COND_NO_ERROR) ? CFDP_TX_DONE : CFDP_TX_ERROR;
+                return tx->state;
+
+            default:
+                return tx->state;
+        }
+    }
+    return tx->state;
+}
@@ -0,0 +1,116 @@
+#include <math.h>
+#include <string.h>
+#include "channel_sim.h"
+
+#define NO_ERROR UINT64_MAX
+
+// xorshift64*: fast, and good enough for impairment statistics
+uint64_t CHSIM_Random(chsim_channel_t *ch) {
+    uint64_t x = ch->rng;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    ch->rng = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static double uniform(chsim_channel_t *ch) {
+    return (double)(CHSIM_Random(ch) >> 11) * (1.0 / 9007199254740992.0);   // [0, 1)
+}
+
+static bool chance(chsim_channel_t *ch, double p) {
+    return p > 0.0 && uniform(ch) < p;
+}
+
+// Independent errors: draw the gap to the next flipped bit (geometric)
+// instead of one Bernoulli trial per bit
+static uint64_t next_gap(chsim_channel_t *ch) {
+    if (ch->cfg.ber <= 0.0) return NO_ERROR;
+    if (ch->cfg.ber >= 1.0) return 0;
+    double u = 1.0 - uniform(ch);   // (0, 1]
+    double gap = floor(log(u) / ch->log_keep);
+    return (gap >= 1e18) ? NO_ERROR : (uint64_t)gap;
+}
+
+static uint8_t error_mask(chsim_channel_t *ch) {
+    uint8_t mask = 0;
+
+    if (ch->cfg.burst) {
+        for (int bit = 0; bit < 8; bit++) {
+            if (ch->bad_state) {
+                if (chance(ch, ch->cfg.ge_p_bad_to_good)) ch->bad_state = false;
+            } else {
+                if (chance(ch, ch->cfg.ge_p_good_to_bad)) ch->bad_state = true;
+            }
+            if (chance(ch, ch->bad_state ? ch->cfg.ge_ber_bad : ch->cfg.ge_ber_good)) {
+                mask |= (uint8_t)(0x80u >> bit);
+            }
+        }
+    } else {
+        unsigned bit = 0;
+        while (ch->next_error != NO_ERROR && ch->next_error < 8u - bit) {
+            bit += (unsigned)ch->next_error;
+            mask |= (uint8_t)(0x80u >> bit);
+            bit++;
+            ch->next_error = next_gap(ch);
+        }
+        if (ch->next_error != NO_ERROR) ch->next_error -= 8u - bit;
+    }
+
+    ch->stats.bits_flipped += (uint64_t)__builtin_popcount(mask);
+    return mask;
+}
+
+void CHSIM_Init(chsim_channel_t *ch, const chsim_config_t *cfg) {
+    memset(ch, 0, sizeof(*ch));
+    ch->cfg = *cfg;
+    // splitmix64 of the seed: never zero, and nearby seeds diverge at once
+    uint64_t z = cfg->seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    ch->rng = (z ^ (z >> 31)) | 1u;
+    ch->log_keep = (cfg->ber > 0.0 && cfg->ber < 1.0) ? log1p(-cfg->ber) : 0.0;
+    ch->next_error = next_gap(ch);
+}
+
+size_t CHSIM_Transmit(chsim_channel_t *ch, const uint8_t *in, size_t len, uint8_t *out, size_t out_cap) {
+    size_t n = 0;
+
+    for (size_t i = 0; i < len && n < out_cap; i++) {
+        ch->stats.bytes_in++;
+
+        // 1. Loss of signal swallows whole runs of bytes
+        if (ch->dropout_left > 0) {
+            ch->dropout_left--;
+            ch->stats.bytes_dropped++;
+            continue;
+        }
+        if (ch->cfg.dropout_len > 0 && chance(ch, ch->cfg.dropout_prob)) {
+            ch->dropout_left = (uint16_t)(ch->cfg.dropout_len - 1);
+            ch->stats.dropouts++;
+            ch->stats.bytes_dropped++;
+            continue;
+        }
+
+        // 2. Byte slips
+        if (chance(ch, ch->cfg.drop_prob)) {
+            ch->stats.bytes_dropped++;
+            continue;
+        }
+        if (chance(ch, ch->cfg.insert_prob)) {
+            out[n++] = (uint8_t)CHSIM_Random(ch);
+            ch->stats.bytes_inserted++;
+            if (n >= out_cap) break;
+        }
+
+        // 3. Bit errors
+        out[n++] = in[i] ^ error_mask(ch);
+    }
+
+    ch->stats.bytes_out += n;
+    return n;
+}
+
+void CHSIM_GetStats(const chsim_channel_t *ch, chsim_stats_t *out) {
+    if (out) *out = ch->stats;
+}
@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <string.h>
+#include "cmd_scheduler.h"
+#include "comms_frame.h"
+#include "byte_order.h"
+#include "time_service.h"
+
+// Command bodies stay put in entries[]; the heap only moves small keys
+typedef struct {
+    uint8_t cmd[SCHED_MAX_CMD_LEN];
+    uint8_t len;
+    uint16_t generation;   // Bumped on reuse so stale handles cannot cancel
+} sched_entry_t;
+
+typedef struct {
+    uint64_t met_ms;
+    uint32_t order;        // Insertion counter, breaks ties FIFO
+    uint16_t slot;
+} sched_key_t;
+
+static sched_entry_t entries[SCHED_CAPACITY];
+static sched_key_t heap[SCHED_CAPACITY];
+static uint16_t heap_pos[SCHED_CAPACITY];     // slot -> heap index
+static uint16_t free_slots[SCHED_CAPACITY];   // Stack of unused slots
+static uint16_t free_top = 0;
+static uint16_t heap_size = 0;
+static uint32_t next_order = 0;
+static sched_stats_t stats;
+
+static bool key_less(const sched_key_t *a, const sched_key_t *b) {
+    return (a->met_ms < b->met_ms) || (a->met_ms == b->met_ms && a->order < b->order);
+}
+
+static void heap_place(uint16_t i, sched_key_t key) {
+    heap[i] = key;
+    heap_pos[key.slot] = i;
+}
+
+static void sift_up(uint16_t i) {
+    sched_key_t key = heap[i];
+    while (i > 0) {
+        uint16_t parent = (uint16_t)((i - 1) / 2);
+        if (!key_less(&key, &heap[parent])) break;
+        heap_place(i, heap[parent]);
+        i = parent;
+    }
+    heap_place(i, key);
+}
+
+static void sift_down(uint16_t i) {
+    sched_key_t key = heap[i];
+    for (;;) {
+        uint16_t child = (uint16_t)(2 * i + 1);
+        if (child >= heap_size) break;
+        if (child + 1 < heap_size && key_less(&heap[child + 1], &heap[child])) child++;
+        if (!key_less(&heap[child], &key)) break;
+        heap_place(i, heap[child]);
+        i = child;
+    }
+    heap_place(i, key);
+}
+
+// Removes heap[i] and returns its slot to the free stack
+static void heap_remove_at(uint16_t i) {
+    uint16_t slot = heap[i].slot;
+    heap_size--;
+    if (i != heap_size) {
+        sched_key_t last = heap[heap_size];
+        heap_place(i, last);
+        if (i > 0 && key_less(&last, &heap[(i - 1) / 2])) {
+            sift_up(i);
+        } else {
+            sift_down(i);
+        }
+    }
+    entries[slot].generation++;
+    free_slots[free_top++] = slot;
+}
+
+static void CMD_TimeTagged(const uint8_t *args, uint8_t args_len) {
+    // The ground has no other way to learn the command will never run
+    if (SCHED_Insert(BE_Load64(args), &args[8], (uint8_t)(args_len - 8)) < 0) {
+        stats.rejected++;
+        printf("[SCHED] ERROR: Store full, time-tagged Command ID 0x%02X rejected.\n", args[8]);
+    }
+}
+
+void SCHED_Init(void) {
+    heap_size = 0;
+    next_order = 0;
+    memset(&stats, 0, sizeof(stats));
+    for (uint16_t i = 0; i < SCHED_CAPACITY; i++) {
+        free_slots[i] = (uint16_t)(SCHED_CAPACITY - 1 - i);
+        entries[i].generation++;
+    }
+    free_top = SCHED_CAPACITY;
+
+    // MET + at least a Command ID, and the wrapped command must fit an entry
+    COMMS_RegisterCommand(CMD_TIME_TAGGED, CMD_TimeTagged, 9, 8 + SCHED_MAX_CMD_LEN);
+}
+
+sched_id_t SCHED_Insert(uint64_t met_ms, const uint8_t *cmd, uint8_t len) {
+    if (cmd == NULL || len == 0 || len > SCHED_MAX_CMD_LEN || free_top == 0) {
+        return -1;
+    }
+
+    // 1. Park the command body in a free slot
+    uint16_t slot = free_slots[--free_top];
+    memcpy(entries[slot].cmd, cmd, len);
+    entries[slot].len = len;
+
+    // 2. Push its key onto the heap
+    sched_key_t key = { met_ms, next_order++, slot };
+    heap_place(heap_size, key);
+    sift_up(heap_size++);
+    stats.inserted++;
+
+    // Handle = generation:slot
+    return (sched_id_t)(((uint32_t)(entries[slot].generation & 0x7FFF) << 16) | slot);
+}
+
+bool SCHED_Cancel(sched_id_t id) {
+    if (id < 0) return false;
+    uint16_t slot = (uint16_t)(id & 0xFFFF);
+    uint16_t gen = (uint16_t)((uint32_t)id >> 16);
+    if (slot >= SCHED_CAPACITY || (entries[slot].generation & 0x7FFF) != gen) return false;
+
+    uint16_t i = heap_pos[slot];
+    if (i >= heap_size || heap[i].slot != slot) return false;
+    heap_remove_at(i);
+    return true;
+}
+
+uint64_t SCHED_PeekNextTime(void) {
+    return (heap_size > 0) ? heap[0].met_ms : SCHED_NO_COMMAND;
+}
+
+int SCHED_Tick(void) {
+    uint64_t now = TIME_GetMilliseconds();
+    int released = 0;
+
+    while (heap_size > 0 && heap[0].met_ms <= now) {
+        // Copy out and pop first so the handler may schedule new commands
+        uint16_t slot = heap[0].slot;
+        uint8_t cmd[SCHED_MAX_CMD_LEN];
+        uint8_t len = entries[slot].len;
+        memcpy(cmd, entries[slot].cmd, len);
+        heap_remove_at(0);
+
+        CCSDS_TcView_t view;
+        memset(&view, 0, sizeof(view));
+        view.apid = APID_CDHS;
+        view.mission_time = now;
+        view.app_data = cmd;
+        view.app_data_len = len;
+        COMMS_DispatchTelecommand(&view);
+        released++;
+    }
+    stats.released += (uint32_t)released;
+    return released;
+}
+
+uint16_t SCHED_Count(void) {
+    return heap_size;
+}
+
+void SCHED_GetStats(sched_stats_t *out) {
+    if (out == NULL) return;
+    *out = stats;
+}
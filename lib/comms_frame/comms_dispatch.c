@@ -0,0 +1,52 @@
+#include <stdio.h>
+#include <string.h>
+#include "comms_frame.h"
+
+// Command jump table: one entry per 8-bit Command ID.
+// Unregistered slots have handler == NULL and are rejected by the length check.
+static comms_cmd_entry_t cmd_table[COMMS_MAX_COMMANDS];
+
+int COMMS_RegisterCommand(uint8_t cmd_id, comms_cmd_handler_t handler, uint8_t min_len, uint8_t max_len) {
+    if (handler == NULL || min_len > max_len) {
+        return -1;
+    }
+    cmd_table[cmd_id].handler = handler;
+    cmd_table[cmd_id].min_len = min_len;
+    cmd_table[cmd_id].max_len = max_len;
+    return 0;
+}
+
+void COMMS_UnregisterCommand(uint8_t cmd_id) {
+    memset(&cmd_table[cmd_id], 0, sizeof(comms_cmd_entry_t));
+}
+
+/**
+ * @brief Shared dispatch path: cmd[0] is the Command ID, the rest are arguments.
+ * @return 1 if a handler ran, 0 if the command was rejected.
+ */
+static int dispatch(const uint8_t *cmd, uint16_t len) {
+    if (cmd == NULL || len == 0) return 0;
+
+    const comms_cmd_entry_t *entry = &cmd_table[cmd[0]];
+    uint16_t arg_len = len - 1;
+
+    // 1. Length validation straight from the table (also rejects empty slots)
+    if (entry->handler == NULL || arg_len < entry->min_len || arg_len > entry->max_len) {
+        printf("[SUB-SYSTEM] ERROR: Rejected Command ID 0x%02X (len %u).\n", cmd[0], arg_len);
+        return 0;
+    }
+
+    // 2. One indexed call
+    entry->handler(&cmd[1], (uint8_t)arg_len);
+    return 1;
+}
+
+void COMMS_DispatchCommand(comms_frame_t *frame) {
+    if (frame == NULL) return;
+    dispatch(frame->payload, frame->length);
+}
+
+int COMMS_DispatchTelecommand(const CCSDS_TcView_t *view) {
+    if (view == NULL) return 0;
+    return dispatch(view->app_data, view->app_data_len);
+}
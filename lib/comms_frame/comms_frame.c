@@ -1,18 +1,46 @@
 #include <stdio.h>
-#include "unity.h"
 #include "../../include/comms_frame.h"
 #include "ccsds_packet.h"
+#include "byte_order.h"
 #include "cdhs_router.h"
+#include "hk_schema.h"
+#include "comms_probe.h"
 #include <string.h>
 
 #define CRC16_POLY 0x1021
 
+// The CRC is computed over the frame structure in place
+_Static_assert(offsetof(comms_frame_t, length) == 1 && offsetof(comms_frame_t, payload) == 2,
+               "comms_frame_t header and payload must be contiguous");
+
 // Global or static variables to track the parser's progress
 static parser_state_t current_state = STATE_SEARCHING_FOR_START;
 static comms_frame_t rx_frame;
 static uint8_t payload_index = 0;
 static uint8_t crc_index = 0;
 static uint16_t received_crc = 0;
+static CCSDS_TcView_t rx_tc_view;   // Decoded header of the last routed telecommand
+
+// Where validated packets go. Defaults to the synchronous CDHS router;
+// RXQ_Init() swaps in the priority queues.
+static void route_direct(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view) {
+    (void)view;
+    CDHS_RoutePacket(packet, len);
+}
+static comms_route_fn_t route_fn = route_direct;
+
+// APID acceptance bitmap: one bit per 11-bit APID (2048 bits = 64 words).
+// Boots with the standard subsystem APIDs accepted and everything else dropped.
+#define APID_FILTER_WORDS (2048 / 32)
+#define APID_BIT_IF(apid, w) ((((apid) >> 5) == (w)) ? (1UL << ((apid) & 31)) : 0UL)
+#define APID_DEFAULT_WORD(w) (uint32_t)(APID_BIT_IF(APID_ADCS, w) | APID_BIT_IF(APID_EPS, w)  | \
+                                        APID_BIT_IF(APID_FDIR, w) | APID_BIT_IF(APID_CDHS, w) | \
+                                        APID_BIT_IF(APID_HK, w)   | APID_BIT_IF(APID_ARCHIVE, w) | \
+                                        APID_BIT_IF(APID_PAYLOAD, w))
+
+static uint32_t apid_filter[APID_FILTER_WORDS] = {
+    APID_DEFAULT_WORD(0), APID_DEFAULT_WORD(1), APID_DEFAULT_WORD(2), APID_DEFAULT_WORD(3)
+};
 
 
 
@@ -26,6 +54,7 @@ int COMMS_ParseByte(uint8_t byte) {
     switch (current_state) {
         case STATE_SEARCHING_FOR_START:
             if (byte == FRAME_START_BYTE) {
+                PROBE_MARK(PROBE_SYNC_FOUND);
                 memset(&rx_frame, 0, sizeof(comms_frame_t));
                 rx_frame.start_byte = byte;
                 current_state = STATE_READING_LENGTH;
@@ -34,6 +63,7 @@ int COMMS_ParseByte(uint8_t byte) {
 
         case STATE_READING_LENGTH:
             if (byte > 0 && byte <= MAX_PAYLOAD_SIZE) {
+                PROBE_MARK(PROBE_LENGTH_OK);
                 rx_frame.length = byte;
                 payload_index = 0;
                 current_state = STATE_READING_PAYLOAD;
@@ -45,6 +75,7 @@ int COMMS_ParseByte(uint8_t byte) {
         case STATE_READING_PAYLOAD:
             rx_frame.payload[payload_index++] = byte;
             if (payload_index >= rx_frame.length) {
+                PROBE_MARK(PROBE_PAYLOAD_DONE);
                 crc_index = 0;
                 received_crc = 0;
                 current_state = STATE_VERIFYING_CRC;
@@ -58,22 +89,28 @@ int COMMS_ParseByte(uint8_t byte) {
             } else {
                 received_crc |= (uint16_t)byte;    // Low Byte
                 
-                // Reconstruct validation buffer
-                uint8_t v_buf[MAX_PAYLOAD_SIZE + 2];
-                v_buf[0] = FRAME_START_BYTE;
-                v_buf[1] = rx_frame.length;
-                for(int i = 0; i < rx_frame.length; i++) {
-                    v_buf[i+2] = rx_frame.payload[i];
-                }
-
-                uint16_t calc_crc = COMMS_CalculateCRC16(v_buf, rx_frame.length + 2);
+                // start_byte, length and payload are contiguous in comms_frame_t,
+                // so the CRC runs over the frame in place (no copy)
+                uint16_t calc_crc = COMMS_CalculateCRC16(&rx_frame.start_byte, rx_frame.length + 2);
+                PROBE_MARK(PROBE_CRC_DONE);
                 
+#ifdef COMMS_TRACE_CRC
                 // Debugging (Keep this until you see the Green Pass!)
                 printf("DEBUG SAT: Calc: 0x%04X, Recv: 0x%04X\n", calc_crc, received_crc);
+#endif
 
                 current_state = STATE_SEARCHING_FOR_START;
                 if (calc_crc == received_crc) {
-                    CDHS_RoutePacket(rx_frame.payload, rx_frame.length);
+                    // Idle fill and unregistered APIDs are dropped with one bit test,
+                    // then only well-formed, non-repeated telecommands reach the router
+                    if (rx_frame.length >= 2 &&
+                        COMMS_IsAPIDAccepted(CCSDS_GetAPID(rx_frame.payload)) &&
+                        CCSDS_ValidateTelecommand(rx_frame.payload, rx_frame.length, &rx_tc_view) == CCSDS_TC_OK &&
+                        COMMS_AcceptSequence(rx_tc_view.apid, rx_tc_view.seq_count)) {
+                        PROBE_MARK(PROBE_ROUTED);
+                        route_fn(rx_frame.payload, rx_frame.length, &rx_tc_view);
+                        PROBE_MARK(PROBE_HANDLER_DONE);
+                    }
                     return 1;
                 }
             }
@@ -82,6 +119,34 @@ int COMMS_ParseByte(uint8_t byte) {
     return 0;
 }
 
+void COMMS_AcceptAPID(uint16_t apid) {
+    apid &= 0x07FF;
+    if (apid == APID_IDLE) return;   // Idle/Fill packets are never routed
+    apid_filter[apid >> 5] |= (1UL << (apid & 31));
+}
+
+void COMMS_RejectAPID(uint16_t apid) {
+    apid &= 0x07FF;
+    apid_filter[apid >> 5] &= ~(1UL << (apid & 31));
+}
+
+void COMMS_ClearAPIDFilter(void) {
+    memset(apid_filter, 0, sizeof(apid_filter));
+}
+
+bool COMMS_IsAPIDAccepted(uint16_t apid) {
+    apid &= 0x07FF;
+    return (apid_filter[apid >> 5] >> (apid & 31)) & 1U;
+}
+
+void COMMS_SetRouteHandler(comms_route_fn_t fn) {
+    route_fn = (fn != NULL) ? fn : route_direct;
+}
+
+const CCSDS_TcView_t* COMMS_GetLastTelecommand(void) {
+    return &rx_tc_view;
+}
+
 void COMMS_ResetParser(void) {
     current_state = STATE_SEARCHING_FOR_START;
     payload_index = 0;
@@ -122,13 +187,24 @@ void COMMS_CreateFrame(comms_frame_t *frame, const uint8_t *payload, uint8_t len
     // 2. Copy the Data
     memcpy(frame->payload, payload, length);
 
-    // 3. Calculate the CRC for the entire packet (except the CRC field itself)
-    uint8_t temp_buffer[MAX_PAYLOAD_SIZE + 2]; 
-    temp_buffer[0] = frame->start_byte;
-    temp_buffer[1] = frame->length;
-    memcpy(&temp_buffer[2], payload, length);
+    // 3. Calculate the CRC over (Start Byte + Length + Payload), which sit
+    //    back to back in the frame structure
+    frame->crc = COMMS_CalculateCRC16(&frame->start_byte, length + 2);
+}
 
-    // Calculate CRC over (Start Byte + Length + Payload)
-    frame->crc = COMMS_CalculateCRC16(temp_buffer, length + 2);
+uint16_t COMMS_SerializeFrame(const comms_frame_t *frame, uint8_t *out) {
+    // Start, length and payload are already contiguous in the structure
+    memcpy(out, &frame->start_byte, (size_t)frame->length + 2);
+    BE_Store16(&out[frame->length + 2], frame->crc);
+    return (uint16_t)(frame->length + 4);
 }
 
+void COMMS_GenerateTelemetry(comms_frame_t *out_frame) {
+    if (out_frame == NULL) return;
+
+    // One consistent snapshot, bit-packed in the HK_SCHEMA layout
+    uint8_t tm[HK_PACKED_BYTES];
+    HK_Pack(tm);
+
+    COMMS_CreateFrame(out_frame, tm, sizeof(tm));
+}
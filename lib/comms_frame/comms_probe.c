@@ -0,0 +1,86 @@
+#ifdef COMMS_PROBES
+
+#include <string.h>
+#include "comms_probe.h"
+#include "ccsds_packet.h"
+#include "byte_order.h"
+#include "tm_downlink.h"
+#include "cycle_counter.h"
+
+static probe_hist_t hists[PROBE_NUM_STAGES];
+static uint32_t frame_start;   // Cycle count at PROBE_SYNC_FOUND
+static uint32_t last_mark;
+
+// 32-bit deltas: wrap-safe as long as a stage takes under 2^32 cycles
+static void record(probe_stage_t stage, uint32_t delta) {
+    probe_hist_t *h = &hists[stage];
+    unsigned bucket = delta ? 32u - (unsigned)__builtin_clz(delta) : 0u;
+    if (bucket >= PROBE_BUCKETS) bucket = PROBE_BUCKETS - 1;
+    h->buckets[bucket]++;
+    h->count++;
+    if (delta > h->max_cycles) h->max_cycles = delta;
+}
+
+void PROBE_Mark(probe_stage_t stage) {
+    uint32_t now = CYCLES_Now();
+
+    if (stage == PROBE_SYNC_FOUND) {
+        frame_start = now;
+        hists[PROBE_SYNC_FOUND].count++;
+    } else if (stage < PROBE_TOTAL) {
+        record(stage, now - last_mark);
+        if (stage == PROBE_ROUTED) record(PROBE_TOTAL, now - frame_start);
+    }
+    last_mark = now;
+}
+
+void PROBE_Reset(void) {
+    memset(hists, 0, sizeof(hists));
+}
+
+void PROBE_GetHistogram(probe_stage_t stage, probe_hist_t *out) {
+    if (out == NULL) return;
+    if ((unsigned)stage >= PROBE_NUM_STAGES) {
+        memset(out, 0, sizeof(*out));
+        return;
+    }
+    *out = hists[stage];
+}
+
+uint16_t PROBE_Encode(probe_stage_t stage, uint8_t *out) {
+    probe_hist_t h;
+    PROBE_GetHistogram(stage, &h);
+
+    // 1. Window starts at the first non-empty bucket
+    unsigned first = 0;
+    while (first < PROBE_BUCKETS - PROBE_WINDOW && h.buckets[first] == 0) first++;
+
+    out[0] = (uint8_t)stage;
+    out[1] = (uint8_t)first;
+    BE_Store32(&out[2], h.count);
+    BE_Store32(&out[6], h.max_cycles);
+
+    // 2. Saturated counts; the tail folds into the last slot
+    for (unsigned i = 0; i < PROBE_WINDOW; i++) {
+        uint32_t n = h.buckets[first + i];
+        if (i == PROBE_WINDOW - 1) {
+            for (unsigned b = first + PROBE_WINDOW; b < PROBE_BUCKETS; b++) n += h.buckets[b];
+        }
+        BE_Store16(&out[10 + 2 * i], (uint16_t)(n > 0xFFFFu ? 0xFFFFu : n));
+    }
+    return PROBE_PACKET_BYTES;
+}
+
+int PROBE_SendPackets(void) {
+    int sent = 0;
+    for (int s = 0; s < PROBE_NUM_STAGES; s++) {
+        if (hists[s].count == 0) continue;
+        uint8_t *p = TM_Reserve(PROBE_APID, PROBE_PACKET_BYTES);
+        if (p == NULL) return -1;
+        PROBE_Encode((probe_stage_t)s, p);
+        if (TM_Commit(p) == 0) sent++;
+    }
+    return sent;
+}
+
+#endif // COMMS_PROBES
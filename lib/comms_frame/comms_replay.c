@@ -0,0 +1,75 @@
+#include <string.h>
+#include "comms_frame.h"
+
+// Per-APID anti-replay state (IPsec-style sliding window over the 14-bit
+// CCSDS Packet Sequence Count). Bit n of window = (top - n) already seen.
+typedef struct {
+    uint32_t window;
+    uint16_t top;      // Highest sequence count accepted so far
+    uint16_t valid;    // 0 until the first packet on this APID
+} replay_state_t;
+
+#define SEQ_MASK      0x3FFF
+#define SEQ_HALF      0x2000
+
+static replay_state_t replay[2048];
+static comms_replay_stats_t replay_stats;
+
+bool COMMS_AcceptSequence(uint16_t apid, uint16_t seq_count) {
+    replay_state_t *st = &replay[apid & 0x07FF];
+    seq_count &= SEQ_MASK;
+
+    if (!st->valid) {
+        st->valid = 1;
+        st->top = seq_count;
+        st->window = 1;
+        replay_stats.accepted++;
+        return true;
+    }
+
+    uint16_t ahead = (uint16_t)((seq_count - st->top) & SEQ_MASK);
+    if (ahead != 0 && ahead < SEQ_HALF) {
+        // Newer than anything seen: slide the window forward
+        st->window = (ahead < COMMS_REPLAY_WINDOW) ? ((st->window << ahead) | 1u) : 1u;
+        st->top = seq_count;
+        replay_stats.accepted++;
+        return true;
+    }
+
+    uint16_t behind = (uint16_t)((st->top - seq_count) & SEQ_MASK);
+    if (behind >= COMMS_REPLAY_WINDOW) {
+        replay_stats.stale++;
+        return false;
+    }
+    uint32_t bit = 1u << behind;
+    if (st->window & bit) {
+        replay_stats.duplicates++;
+        return false;
+    }
+    st->window |= bit;   // Late but not yet seen (reordered retransmission)
+    replay_stats.accepted++;
+    return true;
+}
+
+void COMMS_ReleaseSequence(uint16_t apid, uint16_t seq_count) {
+    replay_state_t *st = &replay[apid & 0x07FF];
+    uint16_t behind = (uint16_t)((st->top - (seq_count & SEQ_MASK)) & SEQ_MASK);
+    if (!st->valid || behind >= COMMS_REPLAY_WINDOW) return;
+
+    // Clearing the bit makes the count look "late but not yet seen", so the
+    // retransmission passes; top stays put and newer counts are unaffected
+    uint32_t bit = 1u << behind;
+    if (st->window & bit) {
+        st->window &= ~bit;
+        replay_stats.released++;
+    }
+}
+
+void COMMS_ResetReplayWindows(void) {
+    memset(replay, 0, sizeof(replay));
+    memset(&replay_stats, 0, sizeof(replay_stats));
+}
+
+void COMMS_GetReplayStats(comms_replay_stats_t *out) {
+    if (out != NULL) *out = replay_stats;
+}
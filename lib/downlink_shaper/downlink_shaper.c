@@ -0,0 +1,207 @@
+#include <string.h>
+#include "downlink_shaper.h"
+#include "ccsds_packet.h"
+#include "frame_pool.h"
+#include "time_service.h"
+
+#define WFQ_SCALE 1024u   // Fixed-point scale for virtual finish times
+
+typedef struct {
+    uint8_t *data;
+    uint16_t len;
+    uint64_t finish;      // WFQ virtual finish tag
+} dls_packet_t;
+
+typedef struct {
+    bool in_use;
+    dls_flow_config_t cfg;
+    uint64_t tokens_milli;     // Bytes * 1000, so slow rates refill without rounding loss
+    uint64_t last_refill_ms;
+    uint64_t last_finish;
+    dls_packet_t queue[DLS_FLOW_DEPTH];
+    uint8_t head;
+    uint8_t count;
+    dls_flow_stats_t stats;
+} dls_flow_t;
+
+static dls_flow_t flows[DLS_MAX_FLOWS];
+static uint8_t apid_flow[2048];        // APID -> flow index (0 = default flow)
+static uint64_t virtual_time = 0;
+static dls_sink_fn tx_sink = NULL;
+
+static void refill(dls_flow_t *f, uint64_t now) {
+    uint64_t dt = now - f->last_refill_ms;
+    if (dt == 0) return;
+    uint64_t cap = (uint64_t)f->cfg.burst * 1000u;
+    f->tokens_milli += dt * f->cfg.rate_bps;
+    if (f->tokens_milli > cap) f->tokens_milli = cap;
+    f->last_refill_ms = now;
+}
+
+// Tokens never exceed the burst, so outside BORROW a packet longer than the
+// burst could never become conformant and would block its flow for good
+static bool fits_burst(const dls_flow_config_t *cfg, uint16_t len) {
+    return cfg->policy == DLS_POLICY_BORROW || len <= cfg->burst;
+}
+
+static void flow_setup(dls_flow_t *f, const dls_flow_config_t *cfg) {
+    memset(f, 0, sizeof(*f));
+    f->in_use = true;
+    f->cfg = *cfg;
+    if (f->cfg.weight == 0) f->cfg.weight = 1;
+    f->tokens_milli = (uint64_t)cfg->burst * 1000u;
+    f->last_refill_ms = TIME_GetMilliseconds();
+}
+
+void DLS_Init(const dls_flow_config_t *default_cfg, dls_sink_fn sink) {
+    for (int i = 0; i < DLS_MAX_FLOWS; i++) {
+        for (int k = 0; k < flows[i].count; k++) {
+            FPOOL_Free(flows[i].queue[(flows[i].head + k) % DLS_FLOW_DEPTH].data);
+        }
+    }
+    memset(flows, 0, sizeof(flows));
+    memset(apid_flow, 0, sizeof(apid_flow));
+    virtual_time = 0;
+    tx_sink = sink;
+
+    if (default_cfg != NULL) {
+        flow_setup(&flows[0], default_cfg);
+    }
+}
+
+int DLS_ConfigureAPID(uint16_t apid, const dls_flow_config_t *cfg) {
+    if (cfg == NULL || cfg->burst == 0) return -1;
+    apid &= 0x07FF;
+
+    // 1. Reconfigure in place if this APID already owns a flow: queued
+    // packets, WFQ tags and earned tokens carry over, capped at the new burst
+    uint8_t idx = apid_flow[apid];
+    if (idx != 0) {
+        dls_flow_t *f = &flows[idx];
+        for (int k = 0; k < f->count; k++) {
+            if (!fits_burst(cfg, f->queue[(f->head + k) % DLS_FLOW_DEPTH].len)) return -1;
+        }
+        refill(f, TIME_GetMilliseconds());
+        f->cfg = *cfg;
+        if (f->cfg.weight == 0) f->cfg.weight = 1;
+        if (f->tokens_milli > (uint64_t)cfg->burst * 1000u) f->tokens_milli = (uint64_t)cfg->burst * 1000u;
+        return 0;
+    }
+
+    // 2. Otherwise take a free flow
+    for (idx = 1; idx < DLS_MAX_FLOWS && flows[idx].in_use; idx++) {
+    }
+    if (idx == DLS_MAX_FLOWS) return -1;
+    flow_setup(&flows[idx], cfg);
+    apid_flow[apid] = idx;
+    return 0;
+}
+
+int DLS_Submit(const uint8_t *packet, uint16_t len) {
+    if (packet == NULL || len < CCSDS_PRIMARY_HDR_SIZE) return -1;
+
+    dls_flow_t *f = &flows[apid_flow[CCSDS_GetAPID(packet)]];
+    if (!f->in_use) return -1;
+    if (!fits_burst(&f->cfg, len)) {
+        f->stats.dropped++;
+        return -1;
+    }
+
+    // 1. Policing: a DROP flow never queues more than its bucket can pay for
+    if (f->cfg.policy == DLS_POLICY_DROP) {
+        refill(f, TIME_GetMilliseconds());
+        uint64_t committed = (uint64_t)len * 1000u;
+        for (int k = 0; k < f->count; k++) {
+            committed += (uint64_t)f->queue[(f->head + k) % DLS_FLOW_DEPTH].len * 1000u;
+        }
+        if (committed > f->tokens_milli) {
+            f->stats.dropped++;
+            return -1;
+        }
+    }
+
+    uint8_t *block = (f->count < DLS_FLOW_DEPTH) ? FPOOL_Alloc(len) : NULL;
+    if (block == NULL) {
+        f->stats.dropped++;
+        return -1;
+    }
+    memcpy(block, packet, len);
+
+    // 2. WFQ finish tag: start at max(virtual time, previous finish)
+    uint64_t start = (f->last_finish > virtual_time) ? f->last_finish : virtual_time;
+    dls_packet_t *p = &f->queue[(f->head + f->count) % DLS_FLOW_DEPTH];
+    p->data = block;
+    p->len = len;
+    p->finish = start + ((uint64_t)len * WFQ_SCALE) / f->cfg.weight;
+    f->last_finish = p->finish;
+    f->count++;
+    f->stats.queued = f->count;
+    return 0;
+}
+
+// Smallest finish tag among flows whose head packet fits the budget
+// (and, unless borrowing, the flow's tokens). Returns -1 if none.
+static int pick_flow(uint32_t budget, bool borrowing) {
+    int best = -1;
+    for (int i = 0; i < DLS_MAX_FLOWS; i++) {
+        dls_flow_t *f = &flows[i];
+        if (!f->in_use || f->count == 0) continue;
+
+        const dls_packet_t *p = &f->queue[f->head];
+        if (p->len > budget) continue;
+        bool conformant = (uint64_t)p->len * 1000u <= f->tokens_milli;
+        if (borrowing ? (conformant || f->cfg.policy != DLS_POLICY_BORROW) : !conformant) continue;
+
+        if (best < 0 || p->finish < flows[best].queue[flows[best].head].finish) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+uint32_t DLS_Service(uint32_t link_budget) {
+    uint64_t now = TIME_GetMilliseconds();
+    uint32_t sent = 0;
+
+    for (int i = 0; i < DLS_MAX_FLOWS; i++) {
+        if (flows[i].in_use) refill(&flows[i], now);
+    }
+
+    for (;;) {
+        // 1. Guaranteed share first, then idle capacity for BORROW flows
+        bool borrowed = false;
+        int idx = pick_flow(link_budget - sent, false);
+        if (idx < 0) {
+            idx = pick_flow(link_budget - sent, true);
+            borrowed = true;
+        }
+        if (idx < 0) break;
+
+        dls_flow_t *f = &flows[idx];
+        dls_packet_t p = f->queue[f->head];
+        f->head = (uint8_t)((f->head + 1) % DLS_FLOW_DEPTH);
+        f->count--;
+
+        // 2. Charge the bucket (borrowed bytes are free: the link was idle)
+        if (!borrowed) {
+            f->tokens_milli -= (uint64_t)p.len * 1000u;
+        } else {
+            f->stats.borrowed_bytes += p.len;
+        }
+        virtual_time = p.finish;
+
+        if (tx_sink != NULL) tx_sink(p.data, p.len);
+        FPOOL_Free(p.data);
+
+        f->stats.sent_packets++;
+        f->stats.sent_bytes += p.len;
+        f->stats.queued = f->count;
+        sent += p.len;
+    }
+    return sent;
+}
+
+void DLS_GetFlowStats(uint16_t apid, dls_flow_stats_t *out) {
+    if (out == NULL) return;
+    *out = flows[apid_flow[apid & 0x07FF]].stats;
+}
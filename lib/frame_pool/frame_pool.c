@@ -0,0 +1,157 @@
+#include <string.h>
+#include "frame_pool.h"
+
+#define FPOOL_EMPTY_TAG_MASK 0xFFFF0000u
+
+// Backing storage, 8-byte aligned so blocks can hold any structure
+static uint64_t small_storage[FPOOL_SMALL_COUNT * FPOOL_SMALL_BLOCK / 8];
+static uint64_t frame_storage[FPOOL_FRAME_COUNT * FPOOL_FRAME_BLOCK / 8];
+static uint64_t large_storage[FPOOL_LARGE_COUNT * FPOOL_LARGE_BLOCK / 8];
+
+// Free-list link per block, stored as (next - index - 1) so that all-zero
+// memory means "next block follows", i.e. the pool starts out fully free.
+static uint16_t small_links[FPOOL_SMALL_COUNT];
+static uint16_t frame_links[FPOOL_FRAME_COUNT];
+static uint16_t large_links[FPOOL_LARGE_COUNT];
+
+// One bit per block, set while it is allocated, so a second free is caught
+static uint32_t small_used[(FPOOL_SMALL_COUNT + 31) / 32];
+static uint32_t frame_used[(FPOOL_FRAME_COUNT + 31) / 32];
+static uint32_t large_used[(FPOOL_LARGE_COUNT + 31) / 32];
+
+typedef struct {
+    uint8_t *base;
+    uint16_t *links;
+    uint32_t *used;
+    uint32_t block_size;
+    uint16_t count;          // index == count marks the end of the list
+    uint32_t head;           // [31:16] ABA tag, [15:0] first free index
+    uint32_t in_use;
+    uint32_t high_water;
+    uint32_t failures;
+    uint32_t bad_frees;
+} fpool_class_state_t;
+
+static fpool_class_state_t classes[FPOOL_NUM_CLASSES] = {
+    { (uint8_t *)small_storage, small_links, small_used, FPOOL_SMALL_BLOCK, FPOOL_SMALL_COUNT, 0, 0, 0, 0, 0 },
+    { (uint8_t *)frame_storage, frame_links, frame_used, FPOOL_FRAME_BLOCK, FPOOL_FRAME_COUNT, 0, 0, 0, 0, 0 },
+    { (uint8_t *)large_storage, large_links, large_used, FPOOL_LARGE_BLOCK, FPOOL_LARGE_COUNT, 0, 0, 0, 0, 0 },
+};
+
+static void *class_pop(fpool_class_state_t *c) {
+    uint32_t head = __atomic_load_n(&c->head, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint16_t idx = (uint16_t)head;
+        if (idx >= c->count) return NULL;
+
+        // A stale link read here is harmless: the tag makes the CAS fail
+        uint16_t next = (uint16_t)(idx + 1u + __atomic_load_n(&c->links[idx], __ATOMIC_RELAXED));
+        uint32_t new_head = ((head + 0x10000u) & FPOOL_EMPTY_TAG_MASK) | next;
+        if (__atomic_compare_exchange_n(&c->head, &head, new_head, true,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            __atomic_fetch_or(&c->used[idx >> 5], 1u << (idx & 31u), __ATOMIC_RELAXED);
+            return c->base + (size_t)idx * c->block_size;
+        }
+    }
+}
+
+static void class_push(fpool_class_state_t *c, uint16_t idx) {
+    uint32_t head = __atomic_load_n(&c->head, __ATOMIC_ACQUIRE);
+    for (;;) {
+        __atomic_store_n(&c->links[idx], (uint16_t)((uint16_t)head - idx - 1u), __ATOMIC_RELAXED);
+        uint32_t new_head = ((head + 0x10000u) & FPOOL_EMPTY_TAG_MASK) | idx;
+        if (__atomic_compare_exchange_n(&c->head, &head, new_head, true,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            return;
+        }
+    }
+}
+
+static void note_alloc(fpool_class_state_t *c) {
+    uint32_t used = __atomic_add_fetch(&c->in_use, 1, __ATOMIC_RELAXED);
+    uint32_t hw = __atomic_load_n(&c->high_water, __ATOMIC_RELAXED);
+    while (used > hw &&
+           !__atomic_compare_exchange_n(&c->high_water, &hw, used, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+void* FPOOL_Alloc(size_t size) {
+    int first_fit = -1;
+    for (int i = 0; i < FPOOL_NUM_CLASSES; i++) {
+        fpool_class_state_t *c = &classes[i];
+        if (size > c->block_size) continue;
+        if (first_fit < 0) first_fit = i;
+
+        void *block = class_pop(c);
+        if (block != NULL) {
+            note_alloc(c);
+            return block;
+        }
+    }
+    if (first_fit >= 0) {
+        __atomic_add_fetch(&classes[first_fit].failures, 1, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+static fpool_class_state_t *class_of(const void *block, uint16_t *idx) {
+    const uint8_t *p = (const uint8_t *)block;
+    for (int i = 0; i < FPOOL_NUM_CLASSES; i++) {
+        fpool_class_state_t *c = &classes[i];
+        size_t span = (size_t)c->count * c->block_size;
+        if (p >= c->base && p < c->base + span) {
+            size_t off = (size_t)(p - c->base);
+            if (off % c->block_size != 0) return NULL;   // Not a block start
+            *idx = (uint16_t)(off / c->block_size);
+            return c;
+        }
+    }
+    return NULL;
+}
+
+void FPOOL_Free(void *block) {
+    if (block == NULL) return;
+    uint16_t idx;
+    fpool_class_state_t *c = class_of(block, &idx);
+    if (c == NULL) return;
+
+    // Only the free that clears the in-use bit may push the block
+    uint32_t bit = 1u << (idx & 31u);
+    if ((__atomic_fetch_and(&c->used[idx >> 5], ~bit, __ATOMIC_RELAXED) & bit) == 0) {
+        __atomic_add_fetch(&c->bad_frees, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    class_push(c, idx);
+    __atomic_sub_fetch(&c->in_use, 1, __ATOMIC_RELAXED);
+}
+
+size_t FPOOL_BlockSize(const void *block) {
+    uint16_t idx;
+    fpool_class_state_t *c = class_of(block, &idx);
+    return (c != NULL) ? c->block_size : 0;
+}
+
+void FPOOL_GetStats(fpool_class_t cls, fpool_stats_t *out) {
+    if (out == NULL || cls >= FPOOL_NUM_CLASSES) return;
+    fpool_class_state_t *c = &classes[cls];
+    out->block_size = c->block_size;
+    out->total = c->count;
+    out->in_use = __atomic_load_n(&c->in_use, __ATOMIC_RELAXED);
+    out->high_water = __atomic_load_n(&c->high_water, __ATOMIC_RELAXED);
+    out->failures = __atomic_load_n(&c->failures, __ATOMIC_RELAXED);
+    out->bad_frees = __atomic_load_n(&c->bad_frees, __ATOMIC_RELAXED);
+}
+
+void FPOOL_Reset(void) {
+    for (int i = 0; i < FPOOL_NUM_CLASSES; i++) {
+        fpool_class_state_t *c = &classes[i];
+        memset(c->links, 0, c->count * sizeof(uint16_t));
+        memset(c->used, 0, ((c->count + 31u) / 32u) * sizeof(uint32_t));
+        __atomic_store_n(&c->head, 0, __ATOMIC_RELEASE);
+        c->in_use = 0;
+        c->high_water = 0;
+        c->failures = 0;
+        c->bad_frees = 0;
+    }
+}
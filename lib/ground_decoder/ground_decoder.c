@@ -0,0 +1,218 @@
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ground_decoder.h"
+#include "comms_frame.h"
+#include "ccsds_packet.h"
+#include "byte_order.h"
+
+// Ground tooling runs on the host, so frame lists grow on the heap
+
+typedef struct {
+    const uint8_t *buf;
+    size_t size;
+    size_t start;          // First candidate position of this chunk
+    size_t stop;           // Frames must start before this
+    gdec_frame_t *frames;
+    size_t count;
+    size_t capacity;
+    int failed;
+} gdec_chunk_t;
+
+// Valid frame at pos? Returns its total size (header + payload + CRC) or 0.
+static size_t frame_at(const uint8_t *buf, size_t size, size_t pos) {
+    if (buf[pos] != FRAME_START_BYTE || size - pos < 2) return 0;
+    uint8_t len = buf[pos + 1];
+    if (len == 0 || len > MAX_PAYLOAD_SIZE) return 0;
+    size_t total = (size_t)len + 4u;
+    if (size - pos < total) return 0;
+    if (COMMS_CalculateCRC16(&buf[pos], (size_t)len + 2u) != BE_Load16(&buf[pos + 2 + len])) return 0;
+    return total;
+}
+
+// Next frame starting in [pos, stop), or stop if there is none
+static size_t next_frame(const uint8_t *buf, size_t size, size_t pos, size_t stop, size_t *total) {
+    while (pos < stop) {
+        const uint8_t *hit = memchr(&buf[pos], FRAME_START_BYTE, stop - pos);
+        if (hit == NULL) break;
+        pos = (size_t)(hit - buf);
+        *total = frame_at(buf, size, pos);
+        if (*total != 0) return pos;
+        pos++;
+    }
+    return stop;
+}
+
+static void make_frame(const uint8_t *buf, size_t pos, gdec_frame_t *f) {
+    f->offset = pos;
+    f->length = buf[pos + 1];
+    f->apid = (f->length >= 2) ? CCSDS_GetAPID(&buf[pos + 2]) : 0;
+}
+
+static int chunk_push(gdec_chunk_t *c, size_t pos) {
+    if (c->count == c->capacity) {
+        size_t cap = c->capacity ? c->capacity * 2 : 1024;
+        gdec_frame_t *grown = realloc(c->frames, cap * sizeof(*grown));
+        if (grown == NULL) return -1;
+        c->frames = grown;
+        c->capacity = cap;
+    }
+    make_frame(c->buf, pos, &c->frames[c->count++]);
+    return 0;
+}
+
+static void *chunk_worker(void *arg) {
+    gdec_chunk_t *c = arg;
+    size_t pos = c->start;
+    size_t total = 0;
+
+    while ((pos = next_frame(c->buf, c->size, pos, c->stop, &total)) < c->stop) {
+        if (chunk_push(c, pos) != 0) {
+            c->failed = 1;
+            break;
+        }
+        pos += total;
+    }
+    return NULL;
+}
+
+// First index in c->frames with offset >= pos
+static size_t lower_bound(const gdec_chunk_t *c, size_t pos) {
+    size_t lo = 0, hi = c->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (c->frames[mid].offset < pos) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+static size_t emit(const uint8_t *buf, const gdec_frame_t *f, gdec_sink_fn sink, void *ctx) {
+    if (sink) sink(ctx, f, &buf[f->offset + 2]);
+    return (size_t)f->offset + f->length + 4u;
+}
+
+// Scans buf[base, end) on `threads` workers and emits its frames in stream
+// order. *resume carries the end of the last emitted frame between windows.
+static int decode_window(const uint8_t *buf, size_t size, size_t base, size_t end,
+                         unsigned threads, gdec_chunk_t *chunks, size_t *resume,
+                         gdec_sink_fn sink, void *ctx, gdec_stats_t *st) {
+    pthread_t workers[GDEC_MAX_THREADS];
+    size_t span = end - base;
+
+    // 1. Split at candidate start bytes; the frame lists keep their capacity
+    for (unsigned i = 0; i < threads; i++) {
+        size_t nominal = base + (span / threads) * i;
+        const uint8_t *hit = (nominal < end) ? memchr(&buf[nominal], FRAME_START_BYTE, end - nominal) : NULL;
+        chunks[i].buf = buf;
+        chunks[i].size = size;
+        chunks[i].count = 0;
+        chunks[i].start = (i == 0) ? base : (hit ? (size_t)(hit - buf) : end);
+        if (i > 0) chunks[i - 1].stop = chunks[i].start;
+    }
+    chunks[threads - 1].stop = end;
+
+    // 2. Scan every chunk in parallel
+    unsigned started = 0;
+    for (; started < threads; started++) {
+        if (pthread_create(&workers[started], NULL, chunk_worker, &chunks[started]) != 0) break;
+    }
+    for (unsigned i = started; i < threads; i++) {
+        chunk_worker(&chunks[i]);   // Could not spawn: scan inline
+    }
+    for (unsigned i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+
+    // 3. Merge in stream order, stitching where a frame crossed a boundary
+    for (unsigned i = 0; i < threads; i++) {
+        gdec_chunk_t *c = &chunks[i];
+        size_t j = 0;
+        if (c->failed) return -1;
+
+        if (*resume > c->start) {
+            // Worker started inside the previous frame: rescan from the true
+            // position until a frame matches one the worker also found
+            j = lower_bound(c, *resume);
+            st->resyncs += j;
+            size_t pos = *resume;
+            size_t total = 0;
+            while ((pos = next_frame(buf, size, pos, c->stop, &total)) < c->stop) {
+                while (j < c->count && c->frames[j].offset < pos) {
+                    j++;
+                    st->resyncs++;
+                }
+                if (j < c->count && c->frames[j].offset == pos) break;   // Back in step
+                gdec_frame_t f;
+                make_frame(buf, pos, &f);
+                *resume = emit(buf, &f, sink, ctx);
+                st->frames++;
+                st->resyncs++;
+                pos += total;
+            }
+            if (pos >= c->stop) {
+                st->resyncs += c->count - j;   // Never got back in step
+                j = c->count;
+            }
+        }
+
+        for (; j < c->count; j++) {
+            *resume = emit(buf, &c->frames[j], sink, ctx);
+            st->frames++;
+        }
+    }
+    return 0;
+}
+
+int GDEC_DecodeBuffer(const uint8_t *buf, size_t size, unsigned threads,
+                      gdec_sink_fn sink, void *ctx, gdec_stats_t *stats) {
+    if (buf == NULL || threads == 0 || threads > GDEC_MAX_THREADS) return -1;
+
+    gdec_chunk_t chunks[GDEC_MAX_THREADS];
+    gdec_stats_t st = { size, 0, 0, threads };
+    size_t window = (size_t)threads * GDEC_CHUNK_BYTES;
+    size_t resume = 0;
+    int rc = 0;
+
+    // One window at a time, so at most `threads` chunks of frames are held
+    memset(chunks, 0, sizeof(chunks));
+    for (size_t base = 0; base < size && rc == 0; base += window) {
+        size_t end = (size - base > window) ? base + window : size;
+        rc = decode_window(buf, size, base, end, threads, chunks, &resume, sink, ctx, &st);
+    }
+
+    for (unsigned i = 0; i < threads; i++) {
+        free(chunks[i].frames);
+    }
+    if (stats) *stats = st;
+    return rc;
+}
+
+int GDEC_DecodeFile(const char *path, unsigned threads,
+                    gdec_sink_fn sink, void *ctx, gdec_stats_t *stats) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+
+    struct stat sb;
+    if (fstat(fd, &sb) != 0) {
+        close(fd);
+        return -1;
+    }
+    if (sb.st_size == 0) {
+        close(fd);
+        if (stats) memset(stats, 0, sizeof(*stats));
+        return 0;
+    }
+
+    void *map = mmap(NULL, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+    madvise(map, (size_t)sb.st_size, MADV_SEQUENTIAL);
+
+    int rc = GDEC_DecodeBuffer(map, (size_t)sb.st_size, threads, sink, ctx, stats);
+    munmap(map, (size_t)sb.st_size);
+    return rc;
+}
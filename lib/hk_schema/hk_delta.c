@@ -0,0 +1,157 @@
+#include <string.h>
+#include "hk_delta.h"
+#include "comms_frame.h"
+#include "tm_downlink.h"
+
+#define HDR_KEYFRAME 0x80u
+#define HDR_CYCLE    0x7Fu
+
+// Runtime MSB-first bit stream (field widths vary per packet here)
+typedef struct {
+    uint8_t *buf;
+    const uint8_t *rbuf;
+    uint32_t pos;
+} bitstream_t;
+
+static void bs_put(bitstream_t *bs, uint32_t val, unsigned bits) {
+    for (unsigned i = 0; i < bits; i++, bs->pos++) {
+        bs->buf[bs->pos >> 3] |= (uint8_t)(((val >> (bits - 1 - i)) & 1u) << (7 - (bs->pos & 7)));
+    }
+}
+
+static uint32_t bs_get(bitstream_t *bs, unsigned bits) {
+    uint32_t val = 0;
+    for (unsigned i = 0; i < bits; i++, bs->pos++) {
+        val = (val << 1) | ((bs->rbuf[bs->pos >> 3] >> (7 - (bs->pos & 7))) & 1u);
+    }
+    return val;
+}
+
+static uint32_t zigzag(int32_t d)  { return ((uint32_t)d << 1) ^ (uint32_t)(d >> 31); }
+static int32_t unzigzag(uint32_t z) { return (int32_t)(z >> 1) ^ -(int32_t)(z & 1u); }
+
+void HK_DeltaEncoderInit(hk_delta_encoder_t *enc, uint8_t keyframe_interval) {
+    memset(enc, 0, sizeof(*enc));
+    enc->keyframe_interval = (keyframe_interval == 0) ? 1 : keyframe_interval;
+}
+
+uint16_t HK_DeltaEncode(hk_delta_encoder_t *enc, const uint32_t raw[HK_NUM_FIELDS], uint8_t *out) {
+    bool keyframe = !enc->primed || enc->since_keyframe + 1 >= enc->keyframe_interval;
+    bitstream_t bs = { out, NULL, 8 };
+
+    memset(out, 0, HK_DELTA_MAX_BYTES);
+    out[0] = (uint8_t)((keyframe ? HDR_KEYFRAME : 0u) | (enc->cycle & HDR_CYCLE));
+
+    if (keyframe) {
+        // 1. Full snapshot in the HK_Pack layout
+        for (int f = 0; f < HK_NUM_FIELDS; f++) {
+            bs.pos = 8u + HK_FIELDS[f].bit_offset;
+            bs_put(&bs, raw[f], HK_FIELDS[f].bits);
+        }
+        bs.pos = 8u + HK_TOTAL_BITS;
+        enc->since_keyframe = 0;
+        enc->primed = true;
+    } else {
+        // 2. Change codes first, then only the changed values
+        uint8_t codes[HK_NUM_FIELDS];
+        for (int f = 0; f < HK_NUM_FIELDS; f++) {
+            const hk_field_desc_t *d = &HK_FIELDS[f];
+            int32_t delta = (int32_t)(raw[f] - enc->prev[f]);
+            int32_t limit = (d->delta_bits > 0) ? (1 << (d->delta_bits - 1)) : 0;
+            if (delta == 0) {
+                codes[f] = HK_DELTA_UNCHANGED;
+            } else if (delta >= -limit && delta < limit) {
+                codes[f] = HK_DELTA_SMALL;
+            } else {
+                codes[f] = HK_DELTA_FULL;
+            }
+            bs_put(&bs, codes[f], 2);
+        }
+        for (int f = 0; f < HK_NUM_FIELDS; f++) {
+            if (codes[f] == HK_DELTA_SMALL) {
+                bs_put(&bs, zigzag((int32_t)(raw[f] - enc->prev[f])), HK_FIELDS[f].delta_bits);
+            } else if (codes[f] == HK_DELTA_FULL) {
+                bs_put(&bs, raw[f], HK_FIELDS[f].bits);
+            }
+        }
+        enc->since_keyframe++;
+    }
+
+    memcpy(enc->prev, raw, sizeof(enc->prev));
+    enc->cycle = (uint8_t)((enc->cycle + 1) & HDR_CYCLE);
+    return (uint16_t)((bs.pos + 7) / 8);
+}
+
+// A packet that passed the cycle check but cannot be applied: the state it
+// carried is lost like a missing packet, so wait for the next keyframe
+static hk_delta_status_t drop_sync(hk_delta_decoder_t *dec) {
+    dec->synced = false;
+    return HK_DELTA_MALFORMED;
+}
+
+void HK_DeltaDecoderInit(hk_delta_decoder_t *dec) {
+    memset(dec, 0, sizeof(*dec));
+}
+
+hk_delta_status_t HK_DeltaDecode(hk_delta_decoder_t *dec, const uint8_t *in, uint16_t len, hk_values_t *out) {
+    if (in == NULL || len < 1) return HK_DELTA_MALFORMED;
+
+    bool keyframe = (in[0] & HDR_KEYFRAME) != 0;
+    uint8_t cycle = in[0] & HDR_CYCLE;
+    bitstream_t bs = { NULL, in, 8 };
+
+    // 1. A gap in the cycle counter means a delta was lost
+    if (dec->synced && cycle != dec->expected_cycle) {
+        dec->synced = false;
+        dec->missed++;
+    }
+    dec->expected_cycle = (uint8_t)((cycle + 1) & HDR_CYCLE);
+
+    if (keyframe) {
+        if (len < 1 + HK_PACKED_BYTES) return drop_sync(dec);
+        for (int f = 0; f < HK_NUM_FIELDS; f++) {
+            bs.pos = 8u + HK_FIELDS[f].bit_offset;
+            dec->state[f] = bs_get(&bs, HK_FIELDS[f].bits);
+        }
+        dec->synced = true;
+    } else {
+        if (!dec->synced) return HK_DELTA_NEED_KEYFRAME;
+        if (len < 1 + (2 * HK_NUM_FIELDS + 7) / 8) return drop_sync(dec);
+
+        uint8_t codes[HK_NUM_FIELDS];
+        uint32_t need = 8u + 2u * HK_NUM_FIELDS;
+        for (int f = 0; f < HK_NUM_FIELDS; f++) {
+            codes[f] = (uint8_t)bs_get(&bs, 2);
+            if (codes[f] > HK_DELTA_FULL) return drop_sync(dec);   // Reserved code
+            need += (codes[f] == HK_DELTA_SMALL) ? HK_FIELDS[f].delta_bits :
+                    (codes[f] == HK_DELTA_FULL)  ? HK_FIELDS[f].bits : 0u;
+        }
+        if (need > (uint32_t)len * 8u) return drop_sync(dec);
+
+        for (int f = 0; f < HK_NUM_FIELDS; f++) {
+            uint32_t mask = (uint32_t)((1ULL << HK_FIELDS[f].bits) - 1);
+            if (codes[f] == HK_DELTA_SMALL) {
+                int32_t delta = unzigzag(bs_get(&bs, HK_FIELDS[f].delta_bits));
+                dec->state[f] = (dec->state[f] + (uint32_t)delta) & mask;
+            } else if (codes[f] == HK_DELTA_FULL) {
+                dec->state[f] = bs_get(&bs, HK_FIELDS[f].bits);
+            }
+        }
+    }
+
+    if (out != NULL) HK_RawToValues(dec->state, out);
+    return HK_DELTA_OK;
+}
+
+int HK_SendDeltaPacket(hk_delta_encoder_t *enc) {
+    uint32_t raw[HK_NUM_FIELDS];
+    uint8_t tmp[HK_DELTA_MAX_BYTES];
+
+    HK_SampleRaw(raw);
+    uint16_t len = HK_DeltaEncode(enc, raw, tmp);
+
+    uint8_t *p = TM_Reserve(APID_HK_DELTA, len);
+    if (p == NULL) return -1;
+    memcpy(p, tmp, len);
+    return TM_Commit(p);
+}
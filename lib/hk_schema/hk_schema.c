@@ -0,0 +1,91 @@
+#include <string.h>
+#include "hk_schema.h"
+#include "comms_frame.h"
+#include "tm_downlink.h"
+
+const hk_field_desc_t HK_FIELDS[HK_NUM_FIELDS] = {
+#define HK_X_DESC(name, src, bits, scale, offset, unit, dbits) \
+    { #name, unit, HK_OFF_##name, bits, dbits, scale, offset },
+    HK_SCHEMA(HK_X_DESC)
+#undef HK_X_DESC
+};
+
+// Every value the parameter database accepts must survive the round trip:
+// a field narrower than its parameter's range would be silently masked
+#define HK_X_RANGE(name, src, bits, scale, offset, unit, dbits) \
+    _Static_assert((int64_t)src##_MIN - (offset) >= 0 && \
+                   ((int64_t)src##_MAX - (offset)) / (scale) <= (int64_t)((1ULL << (bits)) - 1), \
+                   "HK field " #name " cannot hold the full range of " #src);
+HK_SCHEMA(HK_X_RANGE)
+#undef HK_X_RANGE
+
+// A field (<= 32 bits) touches at most 5 bytes. With the constant off/bits
+// generated below the byte loops have a fixed trip count and unroll into
+// straight-line shift/mask code at -O2.
+static inline void put_bits(uint8_t *buf, unsigned off, unsigned bits, uint32_t raw) {
+    unsigned first = off >> 3;
+    unsigned last = (off + bits - 1) >> 3;
+    uint64_t v = (uint64_t)raw << (64 - (off & 7) - bits);
+    for (unsigned b = first; b <= last; b++) {
+        buf[b] |= (uint8_t)(v >> (56 - 8 * (b - first)));
+    }
+}
+
+static inline uint32_t get_bits(const uint8_t *buf, unsigned off, unsigned bits) {
+    unsigned first = off >> 3;
+    unsigned last = (off + bits - 1) >> 3;
+    uint64_t v = 0;
+    for (unsigned b = first; b <= last; b++) {
+        v |= (uint64_t)buf[b] << (56 - 8 * (b - first));
+    }
+    return (uint32_t)((v << (off & 7)) >> (64 - bits));
+}
+
+void HK_Pack(uint8_t *out) {
+    param_snapshot_t snap;
+    PARAM_Snapshot(&snap);
+
+    memset(out, 0, HK_PACKED_BYTES);
+#define HK_X_PACK(name, src, bits, scale, offset, unit, dbits) \
+    put_bits(out, HK_OFF_##name, bits, \
+             (uint32_t)((snap.v[src] - (offset)) / (scale)) & ((1ULL << (bits)) - 1));
+    HK_SCHEMA(HK_X_PACK)
+#undef HK_X_PACK
+}
+
+void HK_SampleRaw(uint32_t raw[HK_NUM_FIELDS]) {
+    param_snapshot_t snap;
+    PARAM_Snapshot(&snap);
+
+#define HK_X_SAMPLE(name, src, bits, scale, offset, unit, dbits) \
+    raw[HK_FIELD_##name] = (uint32_t)((snap.v[src] - (offset)) / (scale)) & ((1ULL << (bits)) - 1);
+    HK_SCHEMA(HK_X_SAMPLE)
+#undef HK_X_SAMPLE
+}
+
+void HK_RawToValues(const uint32_t raw[HK_NUM_FIELDS], hk_values_t *out) {
+#define HK_X_VALUE(name, src, bits, scale, offset, unit, dbits) \
+    out->name = (int32_t)raw[HK_FIELD_##name] * (scale) + (offset);
+    HK_SCHEMA(HK_X_VALUE)
+#undef HK_X_VALUE
+}
+
+void HK_Unpack(const uint8_t *in, hk_values_t *out) {
+#define HK_X_UNPACK(name, src, bits, scale, offset, unit, dbits) \
+    out->name = (int32_t)get_bits(in, HK_OFF_##name, bits) * (scale) + (offset);
+    HK_SCHEMA(HK_X_UNPACK)
+#undef HK_X_UNPACK
+}
+
+int32_t HK_DecodeField(const uint8_t *in, int field) {
+    if (field < 0 || field >= HK_NUM_FIELDS) return 0;
+    const hk_field_desc_t *f = &HK_FIELDS[field];
+    return (int32_t)get_bits(in, f->bit_offset, f->bits) * f->scale + f->offset;
+}
+
+int HK_SendPacket(void) {
+    uint8_t *p = TM_Reserve(APID_HK, HK_PACKED_BYTES);
+    if (p == NULL) return -1;
+    HK_Pack(p);
+    return TM_Commit(p);
+}
@@ -0,0 +1,94 @@
+#include <string.h>
+#include "packet_bus.h"
+#include "frame_pool.h"
+
+typedef struct {
+    pbus_subscriber_fn fn;
+    void *ctx;
+    uint16_t apid;
+} pbus_sub_t;
+
+static pbus_sub_t subs[PBUS_MAX_SUBSCRIBERS];
+static uint32_t buffers_in_use = 0;
+
+void PBUS_Init(void) {
+    memset(subs, 0, sizeof(subs));
+    __atomic_store_n(&buffers_in_use, 0, __ATOMIC_RELAXED);
+}
+
+int PBUS_Subscribe(uint16_t apid, pbus_subscriber_fn fn, void *ctx) {
+    if (fn == NULL) return -1;
+    for (int i = 0; i < PBUS_MAX_SUBSCRIBERS; i++) {
+        if (subs[i].fn == NULL) {
+            subs[i].apid = (apid == PBUS_APID_ANY) ? PBUS_APID_ANY : (apid & 0x07FF);
+            subs[i].ctx = ctx;
+            subs[i].fn = fn;
+            return i;
+        }
+    }
+    return -1;
+}
+
+void PBUS_Unsubscribe(int sub_id) {
+    if (sub_id < 0 || sub_id >= PBUS_MAX_SUBSCRIBERS) return;
+    memset(&subs[sub_id], 0, sizeof(pbus_sub_t));
+}
+
+static int sub_matches(const pbus_sub_t *s, uint16_t apid) {
+    return s->fn != NULL && (s->apid == apid || s->apid == PBUS_APID_ANY);
+}
+
+int PBUS_Publish(const uint8_t *packet, uint16_t len) {
+    if (packet == NULL || len < 2 || len > MAX_PAYLOAD_SIZE) return 0;
+
+    uint16_t apid = CCSDS_GetAPID(packet);
+
+    // 1. Count subscribers first so the refcount is final before anyone can release
+    uint32_t n = 0;
+    for (int i = 0; i < PBUS_MAX_SUBSCRIBERS; i++) {
+        n += sub_matches(&subs[i], apid);
+    }
+    if (n == 0) return 0;
+
+    // 2. One copy into the shared buffer
+    pbus_buffer_t *buf = FPOOL_Alloc(sizeof(pbus_buffer_t) + len);
+    if (buf == NULL) return -1;
+    __atomic_add_fetch(&buffers_in_use, 1, __ATOMIC_RELAXED);
+    memcpy(buf->data, packet, len);
+    buf->len = len;
+    buf->apid = apid;
+    __atomic_store_n(&buf->refcount, n, __ATOMIC_RELEASE);
+
+    // 3. Fan out: each subscriber gets a handle, not a copy
+    int delivered = 0;
+    for (int i = 0; i < PBUS_MAX_SUBSCRIBERS && (uint32_t)delivered < n; i++) {
+        if (sub_matches(&subs[i], apid)) {
+            subs[i].fn(buf, subs[i].ctx);
+            delivered++;
+        }
+    }
+    return delivered;
+}
+
+void PBUS_RouteHandler(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view) {
+    (void)view;
+    PBUS_Publish(packet, len);
+}
+
+void PBUS_Retain(pbus_buffer_t *buf) {
+    if (buf == NULL) return;
+    __atomic_add_fetch(&buf->refcount, 1, __ATOMIC_RELAXED);
+}
+
+void PBUS_Release(pbus_buffer_t *buf) {
+    if (buf == NULL) return;
+    // Last reference returns the buffer to the pool
+    if (__atomic_sub_fetch(&buf->refcount, 1, __ATOMIC_ACQ_REL) == 0) {
+        __atomic_sub_fetch(&buffers_in_use, 1, __ATOMIC_RELAXED);
+        FPOOL_Free(buf);
+    }
+}
+
+int PBUS_BuffersInUse(void) {
+    return (int)__atomic_load_n(&buffers_in_use, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,119 @@
+#include <stdbool.h>
+#include "param_db.h"
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Sleep rather than taskYIELD: the section may be held by a lower priority
+#define PARAM_BACKOFF() vTaskDelay(1)
+#else
+#include <sched.h>
+
+#define PARAM_BACKOFF() sched_yield()
+#endif
+
+#define PARAM_SPIN_LIMIT 64
+
+const param_info_t PARAM_INFO[PARAM_COUNT] = {
+#define PARAM_X_INFO(name, type, min, max, def) { #name, type, min, max, def },
+    PARAM_TABLE(PARAM_X_INFO)
+#undef PARAM_X_INFO
+};
+
+// Statically initialised so the defaults hold before anyone calls Reset
+static int32_t values[PARAM_COUNT] = {
+#define PARAM_X_DEFAULT(name, type, min, max, def) def,
+    PARAM_TABLE(PARAM_X_DEFAULT)
+#undef PARAM_X_DEFAULT
+};
+
+// Odd while a write section is open
+static uint32_t seq = 0;
+static uint32_t retries = 0;
+
+// Busy retries are for a writer on another core; after PARAM_SPIN_LIMIT of
+// them the writer is probably preempted, so hand it the CPU
+static void backoff(uint32_t *spins) {
+    if (++*spins < PARAM_SPIN_LIMIT) return;
+    *spins = 0;
+    PARAM_BACKOFF();
+}
+
+void PARAM_ResetDefaults(void) {
+    for (int i = 0; i < PARAM_COUNT; i++) {
+        values[i] = PARAM_INFO[i].def;
+    }
+    seq = 0;
+    retries = 0;
+}
+
+int32_t PARAM_Get(param_id_t id) {
+    if ((unsigned)id >= PARAM_COUNT) return 0;
+    return __atomic_load_n(&values[id], __ATOMIC_RELAXED);
+}
+
+void PARAM_Snapshot(param_snapshot_t *out) {
+    uint32_t start;
+    uint32_t spins = 0;
+    for (;;) {
+        // 1. Wait for an even sequence (no writer inside)
+        start = __atomic_load_n(&seq, __ATOMIC_ACQUIRE);
+        if (start & 1u) {
+            __atomic_fetch_add(&retries, 1, __ATOMIC_RELAXED);
+            backoff(&spins);
+            continue;
+        }
+
+        // 2. Copy, then check no writer got in meanwhile
+        for (int i = 0; i < PARAM_COUNT; i++) {
+            out->v[i] = __atomic_load_n(&values[i], __ATOMIC_RELAXED);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&seq, __ATOMIC_RELAXED) == start) break;
+        __atomic_fetch_add(&retries, 1, __ATOMIC_RELAXED);
+        backoff(&spins);
+    }
+    out->version = start >> 1;
+}
+
+void PARAM_WriteBegin(void) {
+    // Moving seq from even to odd also excludes other writers
+    uint32_t s = __atomic_load_n(&seq, __ATOMIC_RELAXED);
+    uint32_t spins = 0;
+    for (;;) {
+        if (s & 1u) {
+            backoff(&spins);
+            s = __atomic_load_n(&seq, __ATOMIC_RELAXED);
+            continue;
+        }
+        if (__atomic_compare_exchange_n(&seq, &s, s + 1u, true,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+    // Readers that see any of the new values must also see seq odd
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+void PARAM_WriteEnd(void) {
+    __atomic_fetch_add(&seq, 1u, __ATOMIC_RELEASE);
+}
+
+int PARAM_Store(param_id_t id, int32_t value) {
+    if ((unsigned)id >= PARAM_COUNT) return -1;
+    if (value < PARAM_INFO[id].min || value > PARAM_INFO[id].max) return -1;
+    __atomic_store_n(&values[id], value, __ATOMIC_RELAXED);
+    return 0;
+}
+
+int PARAM_Set(param_id_t id, int32_t value) {
+    PARAM_WriteBegin();
+    int rc = PARAM_Store(id, value);
+    PARAM_WriteEnd();
+    return rc;
+}
+
+uint32_t PARAM_GetRetryCount(void) {
+    return __atomic_load_n(&retries, __ATOMIC_RELAXED);
+}
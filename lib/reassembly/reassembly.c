@@ -0,0 +1,132 @@
+#include <string.h>
+#include "reassembly.h"
+#include "cdhs_router.h"
+#include "time_service.h"
+
+typedef struct {
+    bool active;
+    uint16_t apid;
+    uint16_t next_seq;     // Sequence count the next segment must carry
+    uint32_t len;          // Bytes written so far (offset of the next segment)
+    uint64_t last_ms;      // Arrival time of the latest segment
+    uint8_t data[REASM_MAX_SIZE];
+} reasm_slot_t;
+
+static reasm_slot_t slots[REASM_SLOTS];
+static reasm_stats_t stats;
+static uint32_t timeout_ms = REASM_DEFAULT_TIMEOUT;
+static reasm_sink_fn sink_fn = NULL;
+static void *sink_ctx = NULL;
+
+void REASM_Init(void) {
+    for (int i = 0; i < REASM_SLOTS; i++) slots[i].active = false;
+    memset(&stats, 0, sizeof(stats));
+    timeout_ms = REASM_DEFAULT_TIMEOUT;
+}
+
+void REASM_SetSink(reasm_sink_fn sink, void *ctx) {
+    sink_fn = sink;
+    sink_ctx = ctx;
+}
+
+void REASM_SetTimeout(uint32_t ms) {
+    timeout_ms = ms;
+}
+
+static reasm_slot_t *find_slot(uint16_t apid) {
+    for (int i = 0; i < REASM_SLOTS; i++) {
+        if (slots[i].active && slots[i].apid == apid) return &slots[i];
+    }
+    return NULL;
+}
+
+int REASM_Tick(void) {
+    uint64_t now = TIME_GetMilliseconds();
+    int expired = 0;
+    for (int i = 0; i < REASM_SLOTS; i++) {
+        if (slots[i].active && now - slots[i].last_ms > timeout_ms) {
+            slots[i].active = false;
+            stats.timeouts++;
+            expired++;
+        }
+    }
+    return expired;
+}
+
+// Writes the segment at its final offset; false if it would not fit
+static bool append(reasm_slot_t *slot, const CCSDS_TcView_t *view) {
+    if (slot->len + view->app_data_len > REASM_MAX_SIZE) {
+        slot->active = false;
+        stats.overflows++;
+        return false;
+    }
+    memcpy(&slot->data[slot->len], view->app_data, view->app_data_len);
+    slot->len += view->app_data_len;
+    slot->next_seq = (uint16_t)((view->seq_count + 1u) & 0x3FFF);
+    slot->last_ms = TIME_GetMilliseconds();
+    stats.segments++;
+    return true;
+}
+
+reasm_result_t REASM_Submit(const CCSDS_TcView_t *view) {
+    if (view == NULL) return REASM_DROPPED;
+    if (view->seq_flags == CCSDS_SEQ_UNSEGMENTED) return REASM_PASSTHROUGH;
+
+    REASM_Tick();
+    reasm_slot_t *slot = find_slot(view->apid);
+
+    // 1. FIRST opens a slot (replacing an unfinished packet on the same APID)
+    if (view->seq_flags == CCSDS_SEQ_FIRST) {
+        if (slot != NULL) {
+            stats.restarts++;
+        } else {
+            for (int i = 0; i < REASM_SLOTS && slot == NULL; i++) {
+                if (!slots[i].active) slot = &slots[i];
+            }
+            if (slot == NULL) {
+                stats.no_slot++;
+                return REASM_DROPPED;
+            }
+        }
+        slot->active = true;
+        slot->apid = view->apid;
+        slot->len = 0;
+        return append(slot, view) ? REASM_PENDING : REASM_DROPPED;
+    }
+
+    // 2. CONTINUATION / LAST must follow on directly
+    if (slot == NULL) {
+        stats.orphans++;
+        return REASM_DROPPED;
+    }
+    if (view->seq_count != slot->next_seq) {
+        slot->active = false;
+        stats.gaps++;
+        return REASM_DROPPED;
+    }
+    if (!append(slot, view)) return REASM_DROPPED;
+    if (view->seq_flags == CCSDS_SEQ_CONTINUATION) return REASM_PENDING;
+
+    // 3. LAST: hand the buffer over in place, then free the slot
+    stats.completed++;
+    if (sink_fn != NULL) sink_fn(slot->apid, slot->data, slot->len, sink_ctx);
+    slot->active = false;
+    return REASM_COMPLETE;
+}
+
+void REASM_RouteHandler(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view) {
+    if (REASM_Submit(view) == REASM_PASSTHROUGH) {
+        CDHS_RoutePacket(packet, len);
+    }
+}
+
+int REASM_ActiveSlots(void) {
+    int n = 0;
+    for (int i = 0; i < REASM_SLOTS; i++) n += slots[i].active ? 1 : 0;
+    return n;
+}
+
+void REASM_GetStats(reasm_stats_t *out) {
+    if (out == NULL) return;
+    *out = stats;
+}
@@ -0,0 +1,378 @@
+#ifndef ESP_PLATFORM
+#define _GNU_SOURCE   // pthread_setaffinity_np
+#endif
+#include <string.h>
+#include "rx_pipeline.h"
+#include "cdhs_router.h"
+#include "frame_pool.h"
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+typedef TaskHandle_t rxp_waiter_t;
+
+#define RXP_TASK_STACK 4096
+#define RXP_TASK_PRIO  (tskIDLE_PRIORITY + 5)
+
+#define RXP_SLEEP(w)     ulTaskNotifyTake(pdTRUE, portMAX_DELAY)
+#define RXP_WAKE(w)      do { if (*(w)) xTaskNotifyGive(*(w)); } while (0)
+#define RXP_PAUSE_MS(ms) vTaskDelay(pdMS_TO_TICKS(ms) ? pdMS_TO_TICKS(ms) : 1)
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <time.h>
+
+typedef sem_t rxp_waiter_t;
+
+#define RXP_SLEEP(w)     sem_wait(w)
+#define RXP_WAKE(w)      sem_post(w)
+
+static void rxp_pause_ms(uint32_t ms) {
+    struct timespec ts = { .tv_sec = ms / 1000u, .tv_nsec = (long)(ms % 1000u) * 1000000L };
+    nanosleep(&ts, NULL);
+}
+#define RXP_PAUSE_MS(ms) rxp_pause_ms(ms)
+#endif
+
+#define RXP_INGEST_BATCH 256
+
+_Static_assert((RXP_BYTE_RING & (RXP_BYTE_RING - 1)) == 0, "RXP_BYTE_RING must be a power of 2");
+_Static_assert((RXP_FRAME_DEPTH & (RXP_FRAME_DEPTH - 1)) == 0, "RXP_FRAME_DEPTH must be a power of 2");
+
+// Free-running indices: the producer only writes head, the consumer only
+// writes tail, and each lives on its own cache line so the two cores do
+// not bounce one line between them.
+typedef struct {
+    uint32_t head __attribute__((aligned(64)));
+    uint32_t tail __attribute__((aligned(64)));
+} rxp_indices_t;
+
+typedef struct {
+    uint8_t *data;              // frame_pool block, owned by whoever holds the descriptor
+    uint16_t len;
+    CCSDS_TcView_t view;        // app_data points into data
+} rxp_desc_t;
+
+// One sleeping consumer per ring. A consumer raises sleeping, re-checks its
+// ring and only then blocks; a producer wakes it only if sleeping was set,
+// so the fast path is a single atomic exchange.
+typedef struct {
+    rxp_waiter_t waiter;
+    uint32_t sleeping;
+} rxp_stage_t;
+
+static uint8_t byte_ring[RXP_BYTE_RING];
+static rxp_indices_t byte_idx;
+static rxp_desc_t frame_ring[RXP_FRAME_DEPTH];
+static rxp_indices_t frame_idx;
+
+static rxp_stage_t ingest_stage;
+static rxp_stage_t dispatch_stage;
+static rxp_config_t config;
+static rxp_stats_t stats;
+static bool running = false;        // Written by RXP_Start/Stop, read by both stages
+static bool handed_off;             // Stage 1 queued a packet in the current batch
+
+#define STAT_ADD(field, n) __atomic_store_n(&stats.field, stats.field + (n), __ATOMIC_RELAXED)
+
+static void route_to_cdhs(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view) {
+    (void)view;
+    CDHS_RoutePacket(packet, len);
+}
+
+void RXP_DefaultConfig(rxp_config_t *cfg) {
+    if (cfg == NULL) return;
+    cfg->ingest_core = 0;
+    cfg->dispatch_core = 1;
+    cfg->dispatch = NULL;
+}
+
+static void stage_wake(rxp_stage_t *stage) {
+    if (__atomic_exchange_n(&stage->sleeping, 0u, __ATOMIC_SEQ_CST)) {
+        RXP_WAKE(&stage->waiter);
+    }
+}
+
+// Blocks until the ring looks non-empty or the pipeline stops
+static void stage_wait(rxp_stage_t *stage, const rxp_indices_t *idx) {
+    __atomic_store_n(&stage->sleeping, 1u, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&idx->head, __ATOMIC_SEQ_CST) == idx->tail &&
+        __atomic_load_n(&running, __ATOMIC_SEQ_CST)) {
+        RXP_SLEEP(&stage->waiter);
+    }
+    __atomic_store_n(&stage->sleeping, 0u, __ATOMIC_RELAXED);
+}
+
+size_t RXP_Receive(const uint8_t *data, size_t len) {
+    if (data == NULL || len == 0) return 0;
+
+    // 1. Copy as much as fits, in at most two pieces around the wrap
+    uint32_t head = byte_idx.head;
+    uint32_t used = head - __atomic_load_n(&byte_idx.tail, __ATOMIC_ACQUIRE);
+    size_t n = RXP_BYTE_RING - used;
+    if (n > len) n = len;
+
+    uint32_t at = head & (RXP_BYTE_RING - 1);
+    size_t first = RXP_BYTE_RING - at;
+    if (first > n) first = n;
+    memcpy(&byte_ring[at], data, first);
+    memcpy(byte_ring, data + first, n - first);
+
+    // 2. Publish and nudge stage 1
+    __atomic_store_n(&byte_idx.head, head + (uint32_t)n, __ATOMIC_RELEASE);
+    STAT_ADD(bytes_in, (uint32_t)n);
+    STAT_ADD(bytes_dropped, (uint32_t)(len - n));
+    if (n > 0) stage_wake(&ingest_stage);
+    return n;
+}
+
+// Stage 1 route handler: the parser has validated the packet, hand it across
+static void ingest_handoff(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view) {
+    uint32_t head = frame_idx.head;
+    uint32_t depth = head - __atomic_load_n(&frame_idx.tail, __ATOMIC_ACQUIRE);
+    uint8_t *block = (depth < RXP_FRAME_DEPTH) ? FPOOL_Alloc(len) : NULL;
+
+    if (block == NULL) {
+        // Not delivered, so the retransmission must not count as a replay
+        COMMS_ReleaseSequence(view->apid, view->seq_count);
+        STAT_ADD(frames_dropped, 1);
+        return;
+    }
+
+    rxp_desc_t *desc = &frame_ring[head & (RXP_FRAME_DEPTH - 1)];
+    memcpy(block, packet, len);
+    desc->data = block;
+    desc->len = len;
+    desc->view = *view;
+    desc->view.app_data = block + (view->app_data - packet);
+
+    __atomic_store_n(&frame_idx.head, head + 1u, __ATOMIC_RELEASE);
+    STAT_ADD(frames_queued, 1);
+    if (depth + 1u > stats.frame_high_water) {
+        __atomic_store_n(&stats.frame_high_water, depth + 1u, __ATOMIC_RELAXED);
+    }
+    handed_off = true;
+}
+
+static void ingest_loop(void) {
+    while (__atomic_load_n(&running, __ATOMIC_ACQUIRE)) {
+        uint32_t tail = byte_idx.tail;
+        uint32_t head = __atomic_load_n(&byte_idx.head, __ATOMIC_ACQUIRE);
+        if (head == tail) {
+            stage_wait(&ingest_stage, &byte_idx);
+            continue;
+        }
+        // Hand space back to the radio every RXP_INGEST_BATCH bytes
+        if (head - tail > RXP_INGEST_BATCH) head = tail + RXP_INGEST_BATCH;
+        while (tail != head) {
+            COMMS_ParseByte(byte_ring[tail & (RXP_BYTE_RING - 1)]);
+            tail++;
+        }
+        // Release only after parsing, so an empty ring means nothing is in flight
+        __atomic_store_n(&byte_idx.tail, tail, __ATOMIC_RELEASE);
+
+        // One wake-up per batch rather than per packet
+        if (handed_off) {
+            handed_off = false;
+            stage_wake(&dispatch_stage);
+        }
+    }
+}
+
+static void dispatch_loop(void) {
+    comms_route_fn_t dispatch = (config.dispatch != NULL) ? config.dispatch : route_to_cdhs;
+    while (__atomic_load_n(&running, __ATOMIC_ACQUIRE)) {
+        uint32_t tail = frame_idx.tail;
+        if (__atomic_load_n(&frame_idx.head, __ATOMIC_ACQUIRE) == tail) {
+            stage_wait(&dispatch_stage, &frame_idx);
+            continue;
+        }
+        rxp_desc_t *desc = &frame_ring[tail & (RXP_FRAME_DEPTH - 1)];
+        dispatch(desc->data, desc->len, &desc->view);
+        FPOOL_Free(desc->data);
+        desc->data = NULL;
+        __atomic_store_n(&frame_idx.tail, tail + 1u, __ATOMIC_RELEASE);
+        STAT_ADD(frames_dispatched, 1);
+    }
+}
+
+// Only called with both stages stopped
+static void reset_rings(void) {
+    for (uint32_t i = frame_idx.tail; i != frame_idx.head; i++) {
+        rxp_desc_t *desc = &frame_ring[i & (RXP_FRAME_DEPTH - 1)];
+        // Never dispatched, so the retransmission must not count as a replay
+        COMMS_ReleaseSequence(desc->view.apid, desc->view.seq_count);
+        FPOOL_Free(desc->data);
+    }
+    memset(frame_ring, 0, sizeof(frame_ring));
+    byte_idx.head = byte_idx.tail = 0;
+    frame_idx.head = frame_idx.tail = 0;
+}
+
+#ifdef ESP_PLATFORM
+static bool ingest_done;
+static bool dispatch_done;
+
+// Stages never delete themselves, so a late notification always finds a live task
+static void ingest_task(void *arg) {
+    (void)arg;
+    ingest_loop();
+    __atomic_store_n(&ingest_done, true, __ATOMIC_RELEASE);
+    vTaskSuspend(NULL);
+}
+
+static void dispatch_task(void *arg) {
+    (void)arg;
+    dispatch_loop();
+    __atomic_store_n(&dispatch_done, true, __ATOMIC_RELEASE);
+    vTaskSuspend(NULL);
+}
+
+static BaseType_t core_of(int core) {
+    return (core == RXP_CORE_ANY) ? tskNO_AFFINITY : (BaseType_t)core;
+}
+
+static void stop_stages(void) {
+    if (ingest_stage.waiter != NULL) {
+        xTaskNotifyGive(ingest_stage.waiter);
+        while (!__atomic_load_n(&ingest_done, __ATOMIC_ACQUIRE)) RXP_PAUSE_MS(1);
+        vTaskDelete(ingest_stage.waiter);
+        ingest_stage.waiter = NULL;
+    }
+    if (dispatch_stage.waiter != NULL) {
+        xTaskNotifyGive(dispatch_stage.waiter);
+        while (!__atomic_load_n(&dispatch_done, __ATOMIC_ACQUIRE)) RXP_PAUSE_MS(1);
+        vTaskDelete(dispatch_stage.waiter);
+        dispatch_stage.waiter = NULL;
+    }
+}
+
+static int start_stages(void) {
+    __atomic_store_n(&ingest_done, false, __ATOMIC_RELAXED);
+    __atomic_store_n(&dispatch_done, false, __ATOMIC_RELAXED);
+    if (xTaskCreatePinnedToCore(dispatch_task, "rxp_dispatch", RXP_TASK_STACK, NULL, RXP_TASK_PRIO,
+                                &dispatch_stage.waiter, core_of(config.dispatch_core)) != pdPASS ||
+        xTaskCreatePinnedToCore(ingest_task, "rxp_ingest", RXP_TASK_STACK, NULL, RXP_TASK_PRIO,
+                                &ingest_stage.waiter, core_of(config.ingest_core)) != pdPASS) {
+        __atomic_store_n(&running, false, __ATOMIC_SEQ_CST);
+        stop_stages();
+        return -1;
+    }
+    return 0;
+}
+#else
+static pthread_t ingest_thread;
+static pthread_t dispatch_thread;
+
+static void *ingest_main(void *arg) {
+    (void)arg;
+    ingest_loop();
+    return NULL;
+}
+
+static void *dispatch_main(void *arg) {
+    (void)arg;
+    dispatch_loop();
+    return NULL;
+}
+
+// Best effort: a host with fewer cores simply runs the stage unpinned
+static void pin_thread(pthread_t thread, int core) {
+#ifdef __linux__
+    if (core == RXP_CORE_ANY) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    (void)pthread_setaffinity_np(thread, sizeof(set), &set);
+#else
+    (void)thread;
+    (void)core;
+#endif
+}
+
+static int start_stages(void) {
+    sem_init(&ingest_stage.waiter, 0, 0);
+    sem_init(&dispatch_stage.waiter, 0, 0);
+    if (pthread_create(&dispatch_thread, NULL, dispatch_main, NULL) != 0) {
+        return -1;
+    }
+    if (pthread_create(&ingest_thread, NULL, ingest_main, NULL) != 0) {
+        __atomic_store_n(&running, false, __ATOMIC_SEQ_CST);
+        sem_post(&dispatch_stage.waiter);
+        pthread_join(dispatch_thread, NULL);
+        return -1;
+    }
+    pin_thread(dispatch_thread, config.dispatch_core);
+    pin_thread(ingest_thread, config.ingest_core);
+    return 0;
+}
+
+static void stop_stages(void) {
+    sem_post(&ingest_stage.waiter);
+    sem_post(&dispatch_stage.waiter);
+    pthread_join(ingest_thread, NULL);
+    pthread_join(dispatch_thread, NULL);
+    sem_destroy(&ingest_stage.waiter);
+    sem_destroy(&dispatch_stage.waiter);
+}
+#endif
+
+int RXP_Start(const rxp_config_t *cfg) {
+    if (__atomic_load_n(&running, __ATOMIC_ACQUIRE)) return 0;
+
+    // 1. Fresh rings and counters
+    if (cfg != NULL) {
+        config = *cfg;
+    } else {
+        RXP_DefaultConfig(&config);
+    }
+    reset_rings();
+    memset(&stats, 0, sizeof(stats));
+    ingest_stage.sleeping = dispatch_stage.sleeping = 0;
+    handed_off = false;
+
+    // 2. From here on the parser hands validated packets to stage 2
+    COMMS_ResetParser();
+    COMMS_SetRouteHandler(ingest_handoff);
+
+    // 3. Spin up both stages
+    __atomic_store_n(&running, true, __ATOMIC_SEQ_CST);
+    if (start_stages() != 0) {
+        __atomic_store_n(&running, false, __ATOMIC_SEQ_CST);
+        COMMS_SetRouteHandler(NULL);
+        return -1;
+    }
+    return 0;
+}
+
+void RXP_Stop(void) {
+    if (!__atomic_load_n(&running, __ATOMIC_ACQUIRE)) return;
+    __atomic_store_n(&running, false, __ATOMIC_SEQ_CST);
+    stop_stages();
+    reset_rings();
+    COMMS_SetRouteHandler(NULL);
+}
+
+bool RXP_WaitIdle(uint32_t timeout_ms) {
+    for (uint32_t waited = 0;; waited++) {
+        bool idle = __atomic_load_n(&byte_idx.tail, __ATOMIC_ACQUIRE) ==
+                        __atomic_load_n(&byte_idx.head, __ATOMIC_ACQUIRE) &&
+                    __atomic_load_n(&frame_idx.tail, __ATOMIC_ACQUIRE) ==
+                        __atomic_load_n(&frame_idx.head, __ATOMIC_ACQUIRE);
+        if (idle) return true;
+        if (!__atomic_load_n(&running, __ATOMIC_ACQUIRE) || waited >= timeout_ms) return false;
+        RXP_PAUSE_MS(1);
+    }
+}
+
+void RXP_GetStats(rxp_stats_t *out) {
+    if (out == NULL) return;
+    out->bytes_in = __atomic_load_n(&stats.bytes_in, __ATOMIC_RELAXED);
+    out->bytes_dropped = __atomic_load_n(&stats.bytes_dropped, __ATOMIC_RELAXED);
+    out->frames_queued = __atomic_load_n(&stats.frames_queued, __ATOMIC_RELAXED);
+    out->frames_dropped = __atomic_load_n(&stats.frames_dropped, __ATOMIC_RELAXED);
+    out->frames_dispatched = __atomic_load_n(&stats.frames_dispatched, __ATOMIC_RELAXED);
+    out->frame_high_water = __atomic_load_n(&stats.frame_high_water, __ATOMIC_RELAXED);
+}
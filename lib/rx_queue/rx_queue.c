@@ -0,0 +1,284 @@
+#include <stdio.h>
+#include <string.h>
+#include "rx_queue.h"
+#include "cdhs_router.h"
+#include "frame_pool.h"
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+static portMUX_TYPE rxq_mux = portMUX_INITIALIZER_UNLOCKED;
+static SemaphoreHandle_t rxq_wakeup = NULL;
+static TaskHandle_t rxq_task = NULL;
+static bool rxq_worker_done = false;   // Set by the worker once it no longer routes
+
+// _SAFE variants: RXQ_Enqueue may run from the radio ISR as well as a task
+#define RXQ_LOCK()    portENTER_CRITICAL_SAFE(&rxq_mux)
+#define RXQ_UNLOCK()  portEXIT_CRITICAL_SAFE(&rxq_mux)
+#define RXQ_SIGNAL()  rxq_signal()
+
+// Never called inside the critical section: giving a semaphore may yield
+static inline void rxq_signal(void) {
+    if (rxq_wakeup == NULL) return;
+    if (xPortInIsrContext()) {
+        BaseType_t woken = pdFALSE;
+        xSemaphoreGiveFromISR(rxq_wakeup, &woken);
+        if (woken == pdTRUE) portYIELD_FROM_ISR();
+    } else {
+        xSemaphoreGive(rxq_wakeup);
+    }
+}
+
+#define RXQ_TASK_STACK 4096
+#define RXQ_TASK_PRIO  (tskIDLE_PRIORITY + 5)
+#else
+#include <pthread.h>
+
+static pthread_mutex_t rxq_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t rxq_cond = PTHREAD_COND_INITIALIZER;
+static pthread_t rxq_thread;
+
+#define RXQ_LOCK()    pthread_mutex_lock(&rxq_mutex)
+#define RXQ_UNLOCK()  pthread_mutex_unlock(&rxq_mutex)
+#define RXQ_SIGNAL()  pthread_cond_signal(&rxq_cond)
+#endif
+
+// One bounded ring of descriptors per priority; packet bytes live in the frame pool
+typedef struct {
+    rxq_packet_t slots[RXQ_DEPTH];
+    uint8_t head;
+    uint8_t count;
+} rxq_ring_t;
+
+static rxq_ring_t rings[RXQ_NUM_PRIORITIES];
+static uint32_t nonempty_mask = 0;              // Bit p set while rings[p] has packets
+static uint8_t apid_priority[2048];             // One byte per 11-bit APID
+static rxq_stats_t stats;
+static volatile bool worker_running = false;
+static const CCSDS_TcView_t *current_view = NULL;
+
+void RXQ_SetPriority(uint16_t apid, rxq_priority_t prio) {
+    if (prio >= RXQ_NUM_PRIORITIES) return;
+    apid_priority[apid & 0x07FF] = (uint8_t)prio;
+}
+
+rxq_priority_t RXQ_GetPriority(uint16_t apid) {
+    return (rxq_priority_t)apid_priority[apid & 0x07FF];
+}
+
+void RXQ_Init(void) {
+    RXQ_LOCK();
+    // Return anything still queued to the pool
+    for (int p = 0; p < RXQ_NUM_PRIORITIES; p++) {
+        for (int i = 0; i < rings[p].count; i++) {
+            FPOOL_Free(rings[p].slots[(rings[p].head + i) % RXQ_DEPTH].data);
+        }
+    }
+    memset(rings, 0, sizeof(rings));
+    memset(&stats, 0, sizeof(stats));
+    nonempty_mask = 0;
+    RXQ_UNLOCK();
+
+    // 1. Everything defaults to the lowest priority
+    memset(apid_priority, RXQ_PRIO_PAYLOAD, sizeof(apid_priority));
+
+    // 2. Safety > ADCS > EPS > Payload
+    RXQ_SetPriority(APID_FDIR, RXQ_PRIO_SAFETY);
+    RXQ_SetPriority(APID_CDHS, RXQ_PRIO_SAFETY);
+    RXQ_SetPriority(APID_ADCS, RXQ_PRIO_ADCS);
+    RXQ_SetPriority(APID_EPS, RXQ_PRIO_EPS);
+    RXQ_SetPriority(APID_HK, RXQ_PRIO_EPS);
+
+    // 3. The parser now hands packets to us instead of the router
+    COMMS_SetRouteHandler(RXQ_Enqueue);
+}
+
+void RXQ_Enqueue(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view) {
+    if (packet == NULL || len == 0 || len > MAX_PAYLOAD_SIZE) return;
+
+    uint16_t apid = (view != NULL) ? view->apid : CCSDS_GetAPID(packet);
+    uint8_t prio = apid_priority[apid & 0x07FF];
+    rxq_ring_t *ring = &rings[prio];
+
+    // 1. Copy into a pool block outside the lock
+    uint8_t *block = FPOOL_Alloc(len);
+    if (block != NULL) {
+        memcpy(block, packet, len);
+    }
+
+    RXQ_LOCK();
+    if (block == NULL || ring->count >= RXQ_DEPTH) {
+        stats.dropped[prio]++;
+        RXQ_UNLOCK();
+        FPOOL_Free(block);
+        // Not delivered, so the retransmission must not count as a replay
+        if (view != NULL) COMMS_ReleaseSequence(view->apid, view->seq_count);
+        return;
+    }
+
+    // 2. Queue the descriptor
+    rxq_packet_t *slot = &ring->slots[(ring->head + ring->count) % RXQ_DEPTH];
+    slot->data = block;
+    slot->len = len;
+    if (view != NULL) {
+        // Re-point the view at our copy of the packet
+        slot->view = *view;
+        slot->view.app_data = block + (view->app_data - packet);
+    } else {
+        memset(&slot->view, 0, sizeof(slot->view));
+        slot->view.apid = apid;
+    }
+
+    ring->count++;
+    nonempty_mask |= (1U << prio);
+    stats.enqueued[prio]++;
+    if (ring->count > stats.high_water[prio]) {
+        stats.high_water[prio] = ring->count;
+    }
+    RXQ_UNLOCK();
+
+    // 3. Wake the worker once the lock is released
+    RXQ_SIGNAL();
+}
+
+// Caller holds the lock
+static bool dequeue_locked(rxq_packet_t *out) {
+    if (nonempty_mask == 0) return false;
+
+    // Lowest set bit is the highest priority with data
+    uint8_t prio = (uint8_t)__builtin_ctz(nonempty_mask);
+    rxq_ring_t *ring = &rings[prio];
+
+    // Descriptor hand-off: the pool block moves to the caller, no copy
+    *out = ring->slots[ring->head];
+
+    ring->head = (uint8_t)((ring->head + 1) % RXQ_DEPTH);
+    if (--ring->count == 0) {
+        nonempty_mask &= ~(1U << prio);
+    }
+    return true;
+}
+
+bool RXQ_Dequeue(rxq_packet_t *out) {
+    if (out == NULL) return false;
+    RXQ_LOCK();
+    bool found = dequeue_locked(out);
+    RXQ_UNLOCK();
+    return found;
+}
+
+void RXQ_Release(rxq_packet_t *pkt) {
+    if (pkt == NULL) return;
+    FPOOL_Free(pkt->data);
+    pkt->data = NULL;
+}
+
+static void route_one(rxq_packet_t *pkt) {
+    current_view = &pkt->view;
+    CDHS_RoutePacket(pkt->data, pkt->len);
+    current_view = NULL;
+    RXQ_Release(pkt);
+}
+
+int RXQ_ProcessPending(void) {
+    rxq_packet_t pkt;
+    int routed = 0;
+    while (RXQ_Dequeue(&pkt)) {
+        route_one(&pkt);
+        routed++;
+    }
+    return routed;
+}
+
+const CCSDS_TcView_t* RXQ_GetCurrentTelecommand(void) {
+    return current_view;
+}
+
+void RXQ_GetStats(rxq_stats_t *out) {
+    if (out == NULL) return;
+    RXQ_LOCK();
+    *out = stats;
+    RXQ_UNLOCK();
+}
+
+#ifdef ESP_PLATFORM
+static void rxq_worker(void *arg) {
+    (void)arg;
+    rxq_packet_t pkt;
+    while (worker_running) {
+        xSemaphoreTake(rxq_wakeup, portMAX_DELAY);
+        while (worker_running && RXQ_Dequeue(&pkt)) {
+            route_one(&pkt);
+        }
+    }
+    // RXQ_StopWorker deletes the task once it has seen this
+    __atomic_store_n(&rxq_worker_done, true, __ATOMIC_RELEASE);
+    vTaskSuspend(NULL);
+}
+
+int RXQ_StartWorker(void) {
+    if (worker_running) return 0;
+    if (rxq_wakeup == NULL) {
+        rxq_wakeup = xSemaphoreCreateBinary();
+        if (rxq_wakeup == NULL) return -1;
+    }
+    __atomic_store_n(&rxq_worker_done, false, __ATOMIC_RELAXED);
+    worker_running = true;
+    if (xTaskCreate(rxq_worker, "rxq_worker", RXQ_TASK_STACK, NULL, RXQ_TASK_PRIO, &rxq_task) != pdPASS) {
+        worker_running = false;
+        rxq_task = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+void RXQ_StopWorker(void) {
+    if (!worker_running) return;
+    worker_running = false;
+    xSemaphoreGive(rxq_wakeup);
+
+    // Like pthread_join on the host: no packet is mid-route after this
+    while (!__atomic_load_n(&rxq_worker_done, __ATOMIC_ACQUIRE)) vTaskDelay(1);
+    vTaskDelete(rxq_task);
+    rxq_task = NULL;
+}
+#else
+static void *rxq_worker(void *arg) {
+    (void)arg;
+    rxq_packet_t pkt;
+    RXQ_LOCK();
+    while (worker_running) {
+        if (!dequeue_locked(&pkt)) {
+            pthread_cond_wait(&rxq_cond, &rxq_mutex);
+            continue;
+        }
+        // Route without holding the lock so ingest never waits on a handler
+        RXQ_UNLOCK();
+        route_one(&pkt);
+        RXQ_LOCK();
+    }
+    RXQ_UNLOCK();
+    return NULL;
+}
+
+int RXQ_StartWorker(void) {
+    if (worker_running) return 0;
+    worker_running = true;
+    if (pthread_create(&rxq_thread, NULL, rxq_worker, NULL) != 0) {
+        worker_running = false;
+        return -1;
+    }
+    return 0;
+}
+
+void RXQ_StopWorker(void) {
+    if (!worker_running) return;
+    RXQ_LOCK();
+    worker_running = false;
+    pthread_cond_broadcast(&rxq_cond);
+    RXQ_UNLOCK();
+    pthread_join(rxq_thread, NULL);
+}
+#endif
@@ -0,0 +1,346 @@
+#include <string.h>
+#include "tm_archive.h"
+#include "ccsds_packet.h"
+#include "byte_order.h"
+#include "time_service.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_partition.h"
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#define SECTOR_MAGIC      0x41524348u   // "ARCH"
+#define SECTOR_HDR_SIZE   8             // [magic u32][seq u32]
+#define RECORD_MAGIC      0xA55Au
+#define RECORD_HDR_SIZE   16            // [magic u16][len u16][apid u16][rsv u16][met u64]
+#define RECORD_ALIGN(n)   (((n) + 3u) & ~3u)
+
+// RAM index entry, one per erase sector
+typedef struct {
+    bool valid;
+    uint32_t seq;
+    uint32_t used;         // Bytes written, including the sector header
+    uint32_t records;
+    uint64_t t_min;
+    uint64_t t_max;
+    uint64_t apid_mask;    // Bloom: bit (apid & 63) set if that APID may be present
+} arch_sector_t;
+
+static struct {
+    bool open;
+    const uint8_t *base;   // Memory-mapped view of the whole log
+    uint32_t size;
+    uint16_t nsectors;
+    uint16_t head;         // Sector currently being appended to
+    uint32_t next_seq;
+#ifdef ESP_PLATFORM
+    const esp_partition_t *part;
+    esp_partition_mmap_handle_t map;
+#else
+    int fd;
+    uint8_t *wbase;
+#endif
+} arch;
+
+static arch_sector_t sectors[ARCH_MAX_SECTORS];
+
+// ---- Backend: flash partition on target, mmapped file on host ----
+
+#ifdef ESP_PLATFORM
+static int backend_write(uint32_t off, const void *data, uint32_t len) {
+    return (esp_partition_write(arch.part, off, data, len) == ESP_OK) ? 0 : -1;
+}
+
+static int backend_erase(uint32_t off, uint32_t len) {
+    return (esp_partition_erase_range(arch.part, off, len) == ESP_OK) ? 0 : -1;
+}
+#else
+static int backend_write(uint32_t off, const void *data, uint32_t len) {
+    // Programming only clears bits, as on NOR flash
+    const uint8_t *src = data;
+    for (uint32_t i = 0; i < len; i++) arch.wbase[off + i] &= src[i];
+    return 0;
+}
+
+static int backend_erase(uint32_t off, uint32_t len) {
+    memset(arch.wbase + off, 0xFF, len);   // Same erased state as NOR flash
+    return 0;
+}
+#endif
+
+// ---- Index ----
+
+static uint32_t sector_off(uint16_t s) {
+    return (uint32_t)s * ARCH_SECTOR_SIZE;
+}
+
+static void index_add(arch_sector_t *sec, uint16_t apid, uint64_t met) {
+    if (sec->records == 0 || met < sec->t_min) sec->t_min = met;
+    if (sec->records == 0 || met > sec->t_max) sec->t_max = met;
+    sec->apid_mask |= (1ULL << (apid & 63));
+    sec->records++;
+}
+
+// Rebuilds one sector's index entry by walking its records
+static void index_scan(uint16_t s) {
+    const uint8_t *p = arch.base + sector_off(s);
+    arch_sector_t *sec = &sectors[s];
+    memset(sec, 0, sizeof(*sec));
+
+    if (BE_Load32(p) != SECTOR_MAGIC) return;
+    sec->valid = true;
+    sec->seq = BE_Load32(p + 4);
+    sec->used = SECTOR_HDR_SIZE;
+
+    while (sec->used + RECORD_HDR_SIZE <= ARCH_SECTOR_SIZE) {
+        const uint8_t *r = p + sec->used;
+        uint16_t len = BE_Load16(r + 2);
+        if (BE_Load16(r) != RECORD_MAGIC ||
+            sec->used + RECORD_HDR_SIZE + len > ARCH_SECTOR_SIZE) {
+            break;
+        }
+        index_add(sec, BE_Load16(r + 4), BE_Load64(r + 8));
+        sec->used += RECORD_HDR_SIZE + RECORD_ALIGN(len);
+    }
+}
+
+// True if everything after the last indexed record is still erased. A
+// torn append (packet written, header not) leaves programmed bytes there,
+// and NOR programming only clears bits, so nothing may be written over them.
+static bool sector_tail_erased(uint16_t s) {
+    const uint8_t *p = arch.base + sector_off(s);
+    for (uint32_t i = sectors[s].used; i < ARCH_SECTOR_SIZE; i++) {
+        if (p[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+// Erases sector s (dropping whatever it held) and starts it with a new seq
+static int sector_start(uint16_t s) {
+    uint8_t hdr[SECTOR_HDR_SIZE];
+    if (backend_erase(sector_off(s), ARCH_SECTOR_SIZE) != 0) return -1;
+
+    BE_Store32(hdr, SECTOR_MAGIC);
+    BE_Store32(hdr + 4, arch.next_seq);
+    if (backend_write(sector_off(s), hdr, sizeof(hdr)) != 0) return -1;
+
+    memset(&sectors[s], 0, sizeof(arch_sector_t));
+    sectors[s].valid = true;
+    sectors[s].seq = arch.next_seq++;
+    sectors[s].used = SECTOR_HDR_SIZE;
+    arch.head = s;
+    return 0;
+}
+
+static int arch_mount(void) {
+    bool any = false;
+    arch.next_seq = 1;
+    arch.head = 0;
+
+    // 1. Rebuild the index; the newest sector is where appends continue
+    for (uint16_t s = 0; s < arch.nsectors; s++) {
+        index_scan(s);
+        if (sectors[s].valid && (!any || sectors[s].seq >= arch.next_seq)) {
+            arch.head = s;
+            arch.next_seq = sectors[s].seq + 1;
+            any = true;
+        }
+    }
+
+    // 2. Blank log: start at sector 0. Dirty head after a torn write: keep
+    //    its records but continue in the next sector
+    arch.open = true;
+    if (!any && sector_start(0) != 0) {
+        arch.open = false;
+        return -1;
+    }
+    if (any && !sector_tail_erased(arch.head) &&
+        sector_start((uint16_t)((arch.head + 1) % arch.nsectors)) != 0) {
+        arch.open = false;
+        return -1;
+    }
+    return 0;
+}
+
+#ifdef ESP_PLATFORM
+int ARCH_OpenPartition(const char *label) {
+    const void *ptr;
+    ARCH_Close();
+
+    arch.part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (arch.part == NULL) return -1;
+    if (esp_partition_mmap(arch.part, 0, arch.part->size, ESP_PARTITION_MMAP_DATA, &ptr, &arch.map) != ESP_OK) {
+        return -1;
+    }
+    arch.base = ptr;
+    arch.size = arch.part->size;
+    arch.nsectors = (uint16_t)((arch.size / ARCH_SECTOR_SIZE < ARCH_MAX_SECTORS)
+                               ? arch.size / ARCH_SECTOR_SIZE : ARCH_MAX_SECTORS);
+    return arch_mount();
+}
+
+void ARCH_Close(void) {
+    if (!arch.open) return;
+    esp_partition_munmap(arch.map);
+    memset(&arch, 0, sizeof(arch));
+}
+#else
+int ARCH_OpenFile(const char *path, uint32_t size) {
+    ARCH_Close();
+    size -= size % ARCH_SECTOR_SIZE;
+    if (path == NULL || size < 2 * ARCH_SECTOR_SIZE || size > ARCH_MAX_SECTORS * ARCH_SECTOR_SIZE) {
+        return -1;
+    }
+
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return -1;
+    if (ftruncate(fd, size) != 0) {
+        close(fd);
+        return -1;
+    }
+    void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        close(fd);
+        return -1;
+    }
+
+    arch.fd = fd;
+    arch.wbase = map;
+    arch.base = map;
+    arch.size = size;
+    arch.nsectors = (uint16_t)(size / ARCH_SECTOR_SIZE);
+    return arch_mount();
+}
+
+void ARCH_Close(void) {
+    if (!arch.open) return;
+    msync(arch.wbase, arch.size, MS_SYNC);
+    munmap(arch.wbase, arch.size);
+    close(arch.fd);
+    memset(&arch, 0, sizeof(arch));
+}
+#endif
+
+// ---- Append ----
+
+int ARCH_Store(const uint8_t *packet, uint16_t len) {
+    if (!arch.open || packet == NULL || len < CCSDS_PRIMARY_HDR_SIZE ||
+        RECORD_HDR_SIZE + RECORD_ALIGN(len) > ARCH_SECTOR_SIZE - SECTOR_HDR_SIZE) {
+        return -1;
+    }
+
+    uint16_t apid = CCSDS_GetAPID(packet);
+    uint64_t met = (CCSDS_HasSecondaryHeader(packet) && len >= CCSDS_HEADERS_SIZE)
+                   ? BE_Load64(packet + CCSDS_MET_OFFSET) : TIME_GetMilliseconds();
+    uint32_t rec_size = RECORD_HDR_SIZE + RECORD_ALIGN(len);
+
+    // 1. Full sector: move on, erasing the oldest one in the ring
+    arch_sector_t *sec = &sectors[arch.head];
+    if (sec->used + rec_size > ARCH_SECTOR_SIZE) {
+        if (sector_start((uint16_t)((arch.head + 1) % arch.nsectors)) != 0) return -1;
+        sec = &sectors[arch.head];
+    }
+
+    // 2. Packet first, header last, so a torn write never looks like a record
+    uint8_t hdr[RECORD_HDR_SIZE];
+    uint32_t off = sector_off(arch.head) + sec->used;
+    BE_Store16(hdr, RECORD_MAGIC);
+    BE_Store16(hdr + 2, len);
+    BE_Store16(hdr + 4, apid);
+    BE_Store16(hdr + 6, 0);
+    BE_Store64(hdr + 8, met);
+    if (backend_write(off + RECORD_HDR_SIZE, packet, len) != 0 ||
+        backend_write(off, hdr, sizeof(hdr)) != 0) {
+        return -1;
+    }
+
+    index_add(sec, apid, met);
+    sec->used += rec_size;
+    return 0;
+}
+
+// ---- Query / dump ----
+
+void ARCH_DumpBegin(arch_cursor_t *cursor, uint16_t apid, uint64_t t0_ms, uint64_t t1_ms) {
+    if (cursor == NULL) return;
+    memset(cursor, 0, sizeof(*cursor));
+    cursor->apid = apid;
+    cursor->t0_ms = t0_ms;
+    cursor->t1_ms = t1_ms;
+}
+
+// Valid sector with the smallest seq >= min_seq, or -1
+static int next_sector(uint32_t min_seq) {
+    int best = -1;
+    for (uint16_t s = 0; s < arch.nsectors; s++) {
+        if (sectors[s].valid && sectors[s].seq >= min_seq &&
+            (best < 0 || sectors[s].seq < sectors[best].seq)) {
+            best = s;
+        }
+    }
+    return best;
+}
+
+static bool sector_may_match(const arch_sector_t *sec, const arch_cursor_t *c) {
+    if (sec->records == 0 || sec->t_max < c->t0_ms || sec->t_min > c->t1_ms) return false;
+    return c->apid == ARCH_APID_ANY || (sec->apid_mask & (1ULL << (c->apid & 63)));
+}
+
+int ARCH_DumpNext(arch_cursor_t *cursor, arch_sink_fn sink, int max_packets) {
+    if (cursor == NULL || cursor->done || !arch.open) return 0;
+    int sent = 0;
+
+    while (sent < max_packets) {
+        int s = next_sector(cursor->sector_seq);
+        if (s < 0) {
+            cursor->done = true;
+            break;
+        }
+        const arch_sector_t *sec = &sectors[s];
+        if (sec->seq != cursor->sector_seq) {
+            // Moved on (or our sector was overwritten): start at its first record
+            cursor->sector_seq = sec->seq;
+            cursor->offset = 0;
+        }
+
+        // 1. Index says nothing here can match: skip the whole sector
+        if (!sector_may_match(sec, cursor)) {
+            cursor->sector_seq++;
+            cursor->offset = 0;
+            continue;
+        }
+
+        // 2. Sequential walk through the mapped sector
+        const uint8_t *base = arch.base + sector_off((uint16_t)s);
+        if (cursor->offset == 0) cursor->offset = SECTOR_HDR_SIZE;
+        while (sent < max_packets && cursor->offset < sec->used) {
+            const uint8_t *r = base + cursor->offset;
+            uint16_t len = BE_Load16(r + 2);
+            uint16_t apid = BE_Load16(r + 4);
+            uint64_t met = BE_Load64(r + 8);
+            cursor->offset += RECORD_HDR_SIZE + RECORD_ALIGN(len);
+
+            if ((cursor->apid == ARCH_APID_ANY || apid == cursor->apid) &&
+                met >= cursor->t0_ms && met <= cursor->t1_ms) {
+                if (sink != NULL) sink(r + RECORD_HDR_SIZE, len);
+                sent++;
+            }
+        }
+        if (cursor->offset >= sec->used) {
+            cursor->sector_seq++;
+            cursor->offset = 0;
+        }
+    }
+    return sent;
+}
+
+uint32_t ARCH_RecordCount(void) {
+    uint32_t n = 0;
+    for (uint16_t s = 0; s < arch.nsectors; s++) {
+        if (sectors[s].valid) n += sectors[s].records;
+    }
+    return n;
+}
@@ -0,0 +1,117 @@
+#include <string.h>
+#include "tm_downlink.h"
+#include "frame_pool.h"
+#include "byte_order.h"
+#include "time_service.h"
+
+// Wire layout inside the pool block
+#define WIRE_START_OFFSET   0
+#define WIRE_LENGTH_OFFSET  1
+#define WIRE_PACKET_OFFSET  2
+#define WIRE_APP_OFFSET     (WIRE_PACKET_OFFSET + CCSDS_HEADERS_SIZE)
+
+// Held in the start byte while a block is reserved; commit writes the real
+// FRAME_START_BYTE, so a committed or aborted block no longer matches
+#define WIRE_RESERVED_MARK  0x52
+
+static uint16_t seq_counts[2048];       // Next 14-bit sequence count per APID
+static tm_downlink_sink_fn downlink_sink = NULL;
+
+void TM_SetDownlinkSink(tm_downlink_sink_fn sink) {
+    downlink_sink = sink;
+}
+
+uint8_t* TM_Reserve(uint16_t apid, uint16_t len) {
+    if (len == 0 || len > TM_MAX_APP_DATA) return NULL;
+
+    uint8_t *wire = FPOOL_Alloc(WIRE_APP_OFFSET + len + 2);
+    if (wire == NULL) return NULL;
+
+    // Everything known up front is built now; MET, sequence and CRC wait for commit
+    wire[WIRE_START_OFFSET] = WIRE_RESERVED_MARK;
+    wire[WIRE_LENGTH_OFFSET] = (uint8_t)(CCSDS_HEADERS_SIZE + len);
+    CCSDS_BuildHeaders(&wire[WIRE_PACKET_OFFSET], apid, 0xC000, len, 0);
+    return &wire[WIRE_APP_OFFSET];
+}
+
+// Recovers the block start from the app data pointer handed out by TM_Reserve
+static uint8_t *wire_of(uint8_t *app_data) {
+    if (app_data == NULL) return NULL;
+    uint8_t *wire = app_data - WIRE_APP_OFFSET;
+    return (FPOOL_BlockSize(wire) != 0 && wire[WIRE_START_OFFSET] == WIRE_RESERVED_MARK) ? wire : NULL;
+}
+
+// Stamps seq_ctrl, time and CRC on a reserved frame and hands it to the sink
+static void commit_wire(uint8_t *wire, uint16_t seq_ctrl) {
+    uint8_t *pkt = &wire[WIRE_PACKET_OFFSET];
+    uint16_t pkt_len = wire[WIRE_LENGTH_OFFSET];
+
+    // 1. Start byte, sequence flags + count and time
+    wire[WIRE_START_OFFSET] = FRAME_START_BYTE;
+    BE_Store16(pkt + CCSDS_SEQ_CTRL_OFFSET, seq_ctrl);
+    BE_Store64(pkt + CCSDS_MET_OFFSET, TIME_GetMilliseconds());
+
+    // 2. CRC over Start + Length + Packet, written straight after the packet
+    uint16_t crc = COMMS_CalculateCRC16(wire, (size_t)pkt_len + 2);
+    BE_Store16(&wire[WIRE_PACKET_OFFSET + pkt_len], crc);
+
+    // 3. Hand over the finished frame
+    if (downlink_sink != NULL) {
+        downlink_sink(wire, (uint16_t)(pkt_len + 4));
+    } else {
+        FPOOL_Free(wire);
+    }
+}
+
+int TM_Commit(uint8_t *app_data) {
+    uint8_t *wire = wire_of(app_data);
+    if (wire == NULL) return -1;
+
+    uint16_t apid = CCSDS_GetAPID(&wire[WIRE_PACKET_OFFSET]);
+    uint16_t seq = __atomic_fetch_add(&seq_counts[apid], 1, __ATOMIC_RELAXED) & 0x3FFF;
+    commit_wire(wire, (uint16_t)((CCSDS_SEQ_UNSEGMENTED << 14) | seq));
+    return 0;
+}
+
+int TM_SendSegmented(uint16_t apid, const uint8_t *data, uint32_t len) {
+    if (data == NULL || len == 0) return -1;
+    if (len <= TM_MAX_APP_DATA) {
+        uint8_t *p = TM_Reserve(apid, (uint16_t)len);
+        if (p == NULL) return -1;
+        memcpy(p, data, len);
+        return TM_Commit(p) == 0 ? 1 : -1;
+    }
+
+    uint32_t segments = (len + TM_MAX_APP_DATA - 1) / TM_MAX_APP_DATA;
+    if (segments > TM_MAX_SEGMENTS) return -1;
+
+    // 1. Claim the whole run of sequence counts so no other packet on this
+    //    APID can land between two segments
+    apid &= 0x07FF;
+    uint16_t seq = __atomic_fetch_add(&seq_counts[apid], (uint16_t)segments, __ATOMIC_RELAXED);
+
+    // 2. One frame per segment, built in place like any other TM packet
+    for (uint32_t i = 0; i < segments; i++) {
+        uint32_t offset = i * TM_MAX_APP_DATA;
+        uint16_t chunk = (uint16_t)((len - offset) < TM_MAX_APP_DATA ? (len - offset) : TM_MAX_APP_DATA);
+        uint16_t flags = (i == 0) ? CCSDS_SEQ_FIRST
+                       : (i == segments - 1) ? CCSDS_SEQ_LAST : CCSDS_SEQ_CONTINUATION;
+
+        uint8_t *p = TM_Reserve(apid, chunk);
+        if (p == NULL) return -1;   // Receiver times the partial packet out
+        memcpy(p, data + offset, chunk);
+        commit_wire(wire_of(p), (uint16_t)((flags << 14) | ((seq + i) & 0x3FFF)));
+    }
+    return (int)segments;
+}
+
+void TM_Abort(uint8_t *app_data) {
+    uint8_t *wire = wire_of(app_data);
+    if (wire == NULL) return;
+    wire[WIRE_START_OFFSET] = 0;
+    FPOOL_Free(wire);
+}
+
+void TM_ReleaseFrame(uint8_t *frame) {
+    FPOOL_Free(frame);
+}
@@ -0,0 +1,239 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include "tm_export.h"
+#include "ccsds_packet.h"
+#include "byte_order.h"
+#include "hk_schema.h"
+#include "hk_delta.h"
+
+_Static_assert(sizeof(tmx_column_header_t) == TMX_HEADER_SIZE, "column header must fill TMX_HEADER_SIZE");
+
+enum { COL_MET = 0, COL_SEQ, COL_LEN, COL_PAYLOAD, COL_FIXED };
+#define COL_HK_VALID    COL_FIXED               // Housekeeping streams only
+#define COL_HK_FIELDS   (COL_HK_VALID + 1)
+#define TMX_MAX_COLUMNS (COL_HK_FIELDS + HK_NUM_FIELDS)
+
+typedef struct {
+    FILE *fp;
+    uint8_t *buf;           // TMX_BLOCK_SIZE staging block
+    size_t used;
+} tmx_column_t;
+
+typedef struct {
+    uint16_t apid;
+    uint8_t num_columns;
+    tmx_column_t cols[TMX_MAX_COLUMNS];
+    hk_delta_decoder_t hk_delta;    // APID_HK_DELTA streams only
+} tmx_stream_t;
+
+static struct {
+    bool open;
+    char dir[256];
+    tmx_stream_t streams[TMX_MAX_STREAMS];
+    tmx_stats_t stats;
+} tmx;
+
+static int column_flush(tmx_column_t *c) {
+    if (c->used == 0) return 0;
+    size_t n = fwrite(c->buf, 1, c->used, c->fp);
+    tmx.stats.bytes_written += n;
+    int rc = (n == c->used) ? 0 : -1;
+    c->used = 0;
+    return rc;
+}
+
+static int column_open(tmx_column_t *c, const char *stream_dir, uint16_t apid,
+                       const char *name, tmx_type_t type, uint8_t elem_size) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s.col", stream_dir, name);
+
+    c->fp = fopen(path, "ab");
+    c->buf = malloc(TMX_BLOCK_SIZE);
+    c->used = 0;
+    if (c->fp == NULL || c->buf == NULL) return -1;
+
+    // New file: write the header so the data array starts aligned
+    if (ftell(c->fp) == 0) {
+        tmx_column_header_t hdr;
+        memset(&hdr, 0, sizeof(hdr));
+        memcpy(hdr.magic, TMX_MAGIC, 4);
+        hdr.version = 1;
+        hdr.type = (uint8_t)type;
+        hdr.elem_size = elem_size;
+        hdr.apid = apid;
+        strncpy(hdr.name, name, sizeof(hdr.name) - 1);
+        memcpy(c->buf, &hdr, sizeof(hdr));
+        c->used = sizeof(hdr);
+    }
+    return 0;
+}
+
+static int stream_close(tmx_stream_t *s) {
+    int rc = 0;
+    for (int c = 0; c < TMX_MAX_COLUMNS; c++) {
+        if (s->cols[c].fp) {
+            rc |= column_flush(&s->cols[c]);
+            rc |= fclose(s->cols[c].fp);
+        }
+        free(s->cols[c].buf);
+        memset(&s->cols[c], 0, sizeof(s->cols[c]));
+    }
+    s->num_columns = 0;
+    return rc;
+}
+
+static tmx_stream_t *stream_get(uint16_t apid) {
+    tmx_stream_t *free_slot = NULL;
+    for (int i = 0; i < TMX_MAX_STREAMS; i++) {
+        if (tmx.streams[i].num_columns && tmx.streams[i].apid == apid) return &tmx.streams[i];
+        if (!tmx.streams[i].num_columns && free_slot == NULL) free_slot = &tmx.streams[i];
+    }
+    if (free_slot == NULL) return NULL;
+
+    char stream_dir[300];
+    snprintf(stream_dir, sizeof(stream_dir), "%s/apid_%03X", tmx.dir, apid);
+    if (mkdir(stream_dir, 0755) != 0 && errno != EEXIST) return NULL;
+
+    tmx_stream_t *s = free_slot;
+    s->apid = apid;
+    int rc = column_open(&s->cols[COL_MET], stream_dir, apid, "met", TMX_TYPE_U64, 8);
+    rc |= column_open(&s->cols[COL_SEQ], stream_dir, apid, "seq", TMX_TYPE_U16, 2);
+    rc |= column_open(&s->cols[COL_LEN], stream_dir, apid, "len", TMX_TYPE_U16, 2);
+    rc |= column_open(&s->cols[COL_PAYLOAD], stream_dir, apid, "payload", TMX_TYPE_U8, 1);
+    s->num_columns = COL_FIXED;
+    if (apid == APID_HK || apid == APID_HK_DELTA) {
+        HK_DeltaDecoderInit(&s->hk_delta);
+        rc |= column_open(&s->cols[COL_HK_VALID], stream_dir, apid, "hk_valid", TMX_TYPE_U8, 1);
+        for (int f = 0; f < HK_NUM_FIELDS; f++) {
+            rc |= column_open(&s->cols[COL_HK_FIELDS + f], stream_dir, apid, HK_FIELDS[f].name, TMX_TYPE_I32, 4);
+        }
+        s->num_columns = TMX_MAX_COLUMNS;
+    }
+    if (rc != 0) {
+        stream_close(s);
+        return NULL;
+    }
+    tmx.stats.streams++;
+    return s;
+}
+
+static int column_put(tmx_column_t *c, const void *data, size_t n) {
+    const uint8_t *p = data;
+    while (n > 0) {
+        size_t room = TMX_BLOCK_SIZE - c->used;
+        size_t take = (n < room) ? n : room;
+        memcpy(&c->buf[c->used], p, take);
+        c->used += take;
+        p += take;
+        n -= take;
+        if (c->used == TMX_BLOCK_SIZE && column_flush(c) != 0) return -1;
+    }
+    return 0;
+}
+
+// Columns are little-endian regardless of host order
+static int column_put_le(tmx_column_t *c, uint64_t v, uint8_t size) {
+    uint8_t le[8];
+    for (int i = 0; i < size; i++) le[i] = (uint8_t)(v >> (8 * i));
+    return column_put(c, le, size);
+}
+
+int TMX_Open(const char *dir) {
+    if (tmx.open || dir == NULL) return -1;
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST) return -1;
+
+    memset(&tmx, 0, sizeof(tmx));
+    snprintf(tmx.dir, sizeof(tmx.dir), "%s", dir);
+    tmx.open = true;
+    return 0;
+}
+
+int TMX_Append(const uint8_t *packet, uint16_t len) {
+    if (!tmx.open) return -1;
+
+    // 1. Primary Header, and a length that agrees with what we were given
+    if (packet == NULL || len < CCSDS_PRIMARY_HDR_SIZE) {
+        tmx.stats.rejected++;
+        return -1;
+    }
+    uint16_t apid = CCSDS_GetAPID(packet);
+    uint16_t seq = BE_Load16(packet + CCSDS_SEQ_CTRL_OFFSET) & 0x3FFF;
+    uint32_t total = CCSDS_PRIMARY_HDR_SIZE + (uint32_t)BE_Load16(packet + CCSDS_LENGTH_OFFSET) + 1u;
+    bool sec = CCSDS_HasSecondaryHeader(packet);
+    uint16_t hdr = sec ? CCSDS_HEADERS_SIZE : CCSDS_PRIMARY_HDR_SIZE;
+    if (total > len || total < hdr) {
+        tmx.stats.rejected++;
+        return -1;
+    }
+
+    tmx_stream_t *s = stream_get(apid);
+    if (s == NULL) {
+        tmx.stats.rejected++;
+        return -1;
+    }
+
+    // 2. One row in every column of the stream
+    uint16_t app_len = (uint16_t)(total - hdr);
+    uint64_t met = sec ? BE_Load64(packet + CCSDS_MET_OFFSET) : 0;
+    int rc = column_put_le(&s->cols[COL_MET], met, 8);
+    rc |= column_put_le(&s->cols[COL_SEQ], seq, 2);
+    rc |= column_put_le(&s->cols[COL_LEN], app_len, 2);
+    rc |= column_put(&s->cols[COL_PAYLOAD], packet + hdr, app_len);
+
+    if (s->num_columns > COL_FIXED) {
+        // HK fields stay row-aligned with met/seq: undecodable rows get 0
+        // and hk_valid 0, so a real 0 reading is never confused with a gap
+        hk_values_t v;
+        bool valid = false;
+        memset(&v, 0, sizeof(v));
+        if (apid == APID_HK_DELTA) {
+            valid = HK_DeltaDecode(&s->hk_delta, packet + hdr, app_len, &v) == HK_DELTA_OK;
+        } else if (app_len == HK_PACKED_BYTES) {
+            HK_Unpack(packet + hdr, &v);
+            valid = true;
+        }
+        rc |= column_put_le(&s->cols[COL_HK_VALID], valid, 1);
+#define TMX_X_HK_COLUMN(name, src, bits, scale, offset, unit, dbits) \
+        rc |= column_put_le(&s->cols[COL_HK_FIELDS + HK_FIELD_##name], (uint32_t)v.name, 4);
+        HK_SCHEMA(TMX_X_HK_COLUMN)
+#undef TMX_X_HK_COLUMN
+    }
+
+    tmx.stats.packets++;
+    return rc;
+}
+
+void TMX_GdecSink(void *ctx, const gdec_frame_t *frame, const uint8_t *payload) {
+    (void)ctx;
+    TMX_Append(payload, frame->length);
+}
+
+int TMX_Flush(void) {
+    int rc = 0;
+    for (int i = 0; i < TMX_MAX_STREAMS; i++) {
+        tmx_stream_t *s = &tmx.streams[i];
+        for (int c = 0; c < s->num_columns; c++) {
+            if (s->cols[c].fp == NULL) continue;
+            rc |= column_flush(&s->cols[c]);
+            rc |= fflush(s->cols[c].fp);
+        }
+    }
+    return rc;
+}
+
+int TMX_Close(void) {
+    if (!tmx.open) return -1;
+    int rc = 0;
+    for (int i = 0; i < TMX_MAX_STREAMS; i++) {
+        rc |= stream_close(&tmx.streams[i]);
+    }
+    tmx.open = false;
+    return rc;
+}
+
+void TMX_GetStats(tmx_stats_t *out) {
+    if (out) *out = tmx.stats;
+}
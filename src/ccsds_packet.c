@@ -1,16 +1,13 @@
 #include "ccsds_packet.h"
+#include "byte_order.h"
 #include "time_service.h"
 #include <string.h>
-#include <arpa/inet.h>   // For htons/ntohs (Big-Endian conversion)
 
 uint16_t CCSDS_GetAPID(const uint8_t* buffer){
     if(!buffer) return 0;
 
-    // Map the buffer to the struct
-    CCSDS_PrimaryHeader_t* hdr = (CCSDS_PrimaryHeader_t*)buffer;
-    
-    // 1. Convert from Big-Endian (Network) to Little-Endian (Host)
-    uint16_t id = ntohs(hdr->packet_id);
+    // 1. Read the Big-Endian Packet ID byte by byte (no unaligned struct access)
+    uint16_t id = BE_Load16(buffer + CCSDS_PACKET_ID_OFFSET);
 
     // 2. Mask the last 11 bits (0x07FF = 0000 0111 1111 1111)
     return (id & 0x07FF);
@@ -19,8 +16,7 @@ uint16_t CCSDS_GetAPID(const uint8_t* buffer){
 bool CCSDS_HasSecondaryHeader(const uint8_t* buffer) {
     if (!buffer) return false;
     
-    CCSDS_PrimaryHeader_t* hdr = (CCSDS_PrimaryHeader_t*)buffer;
-    uint16_t id = ntohs(hdr->packet_id);
+    uint16_t id = BE_Load16(buffer + CCSDS_PACKET_ID_OFFSET);
     
     // Secondary Header Flag is bit 11 (counting from right, 0-indexed)
     // Mask: 0x0800 (0000 1000 0000 0000)
@@ -28,26 +24,64 @@ bool CCSDS_HasSecondaryHeader(const uint8_t* buffer) {
 }
 
 
-void CCSDS_WrapTelemetry(uint16_t apid, const uint8_t* app_data, uint16_t app_data_len, uint8_t* out_buffer){
-    CCSDS_PrimaryHeader_t* pri_hdr = (CCSDS_PrimaryHeader_t*)out_buffer;
-    CCSDS_SecondaryHeader_t* sec_hdr = (CCSDS_SecondaryHeader_t*)(out_buffer + sizeof(CCSDS_PrimaryHeader_t));
-
+void CCSDS_BuildHeaders(uint8_t* out_buffer, uint16_t apid, uint16_t seq_ctrl, uint16_t app_data_len, uint64_t met){
     // 1. Build Packet ID (Version 0, Type 1 (TM), Sec Hdr 1, APID)
     // 0x1800 sets the Type bit and the Secondary Header flag bit
     uint16_t id = 0x1800 | (apid & 0x07FF);
-    pri_hdr ->packet_id = htons(id);  // Flip to big-endian
+    BE_Store16(out_buffer + CCSDS_PACKET_ID_OFFSET, id);
     
-    // 2. Sequence Control (For now, let's just set "Unsegmented" flags 0xC000)
-    pri_hdr->sequence_ctrl = htons(0xC000);
+    // 2. Sequence Control (flags + 14-bit count)
+    BE_Store16(out_buffer + CCSDS_SEQ_CTRL_OFFSET, seq_ctrl);
 
     // 3. Length: (Sec Hdr size + App Data size) - 1
-    uint16_t total_len = sizeof(CCSDS_SecondaryHeader_t) + app_data_len - 1;
-    pri_hdr->packet_length = htons(total_len);
+    uint16_t total_len = CCSDS_SECONDARY_HDR_SIZE + app_data_len - 1;
+    BE_Store16(out_buffer + CCSDS_LENGTH_OFFSET, total_len);
 
     // 4. Set the Time in Secondary Header
-    uint64_t now = TIME_GetMilliseconds();
-    sec_hdr->mission_time = __builtin_bswap64(now);
+    BE_Store64(out_buffer + CCSDS_MET_OFFSET, met);
+}
+
+void CCSDS_WrapTelemetry(uint16_t apid, const uint8_t* app_data, uint16_t app_data_len, uint8_t* out_buffer){
+    // 1. Headers: for now, "Unsegmented" flags 0xC000 and the current MET
+    CCSDS_BuildHeaders(out_buffer, apid, 0xC000, app_data_len, TIME_GetMilliseconds());
+
+    // 2. Copy the actual data (ADCS, EPS, etc.) after the headers
+    memcpy(out_buffer + CCSDS_HEADERS_SIZE, app_data, app_data_len);
+}
+
+
+CCSDS_TcStatus_t CCSDS_ValidateTelecommand(const uint8_t* buffer, uint16_t frame_len, CCSDS_TcView_t* view){
+    if (!buffer || frame_len < CCSDS_PRIMARY_HDR_SIZE) return CCSDS_TC_ERR_SHORT;
+
+    // 1. Read the whole Primary Header once
+    uint16_t id   = BE_Load16(buffer + CCSDS_PACKET_ID_OFFSET);
+    uint16_t seq  = BE_Load16(buffer + CCSDS_SEQ_CTRL_OFFSET);
+    uint32_t data_len = (uint32_t)BE_Load16(buffer + CCSDS_LENGTH_OFFSET) + 1;
+    uint32_t apid = id & 0x07FF;
+    uint32_t sec  = (id >> 11) & 0x1;
 
-    // 5. Copy the actual data (ADCS, EPS, etc.) after the headers
-    memcpy(out_buffer + sizeof(CCSDS_PrimaryHeader_t) + sizeof(CCSDS_SecondaryHeader_t), app_data, app_data_len);
-}
\ No newline at end of file
+    // 2. Evaluate every check without branching; each failure sets one bit
+    //    in the same order as CCSDS_TcStatus_t
+    uint32_t err = 0;
+    err |= (uint32_t)((id >> 13) != 0) << 0;                                  // Version
+    err |= (uint32_t)((id & 0x1000) == 0) << 1;                               // Type (1 = TC)
+    err |= (uint32_t)((apid - CCSDS_TC_APID_MIN) >
+                      (CCSDS_TC_APID_MAX - CCSDS_TC_APID_MIN)) << 2;          // APID range
+    err |= (uint32_t)(((data_len + CCSDS_PRIMARY_HDR_SIZE) != frame_len) |
+                      (data_len < sec * CCSDS_SECONDARY_HDR_SIZE)) << 3;      // Length
+
+    // 3. Lowest set bit is the first failing check
+    if (err) return (CCSDS_TcStatus_t)(__builtin_ctz(err) + 1);
+
+    if (view) {
+        uint16_t hdr_len = (uint16_t)(CCSDS_PRIMARY_HDR_SIZE + sec * CCSDS_SECONDARY_HDR_SIZE);
+        view->apid = (uint16_t)apid;
+        view->seq_flags = (uint8_t)(seq >> 14);
+        view->seq_count = seq & 0x3FFF;
+        view->has_sec_hdr = (sec != 0);
+        view->mission_time = sec ? BE_Load64(buffer + CCSDS_MET_OFFSET) : 0;
+        view->app_data = buffer + hdr_len;
+        view->app_data_len = (uint16_t)(frame_len - hdr_len);
+    }
+    return CCSDS_TC_OK;
+}
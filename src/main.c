@@ -1 +1,32 @@
-void app_main() {}
\ No newline at end of file
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "mission_commands.h"
+#include "cmd_scheduler.h"
+#include "rx_queue.h"
+
+#define CMD_TASK_PERIOD_MS 10    // Time-tag release resolution
+#define CMD_TASK_STACK     4096
+#define CMD_TASK_PRIO      (tskIDLE_PRIORITY + 5)
+
+// The command-handling task: routes queued uplink and releases due
+// time-tagged commands, so SCHED_Insert (via CMD_TIME_TAGGED) and
+// SCHED_Tick always run in this one context
+static void cmd_task(void *arg) {
+    (void)arg;
+    TickType_t last_wake = xTaskGetTickCount();
+    for (;;) {
+        RXQ_ProcessPending();
+        SCHED_Tick();
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(CMD_TASK_PERIOD_MS));
+    }
+}
+
+void app_main() {
+    // 1. Handlers first, then the scheduler's CMD_TIME_TAGGED wrapper
+    MISSION_RegisterCommands();
+    SCHED_Init();
+
+    // 2. The parser only enqueues; routing happens on the command task
+    RXQ_Init();
+    xTaskCreate(cmd_task, "cmd_task", CMD_TASK_STACK, NULL, CMD_TASK_PRIO, NULL);
+}
@@ -0,0 +1,41 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include "comms_frame.h"
+#include "mission_commands.h"
+#include "param_db.h"
+
+#define ALTITUDE_GAIN_PER_SEC 100   // Meters gained per second of burn
+
+// CMD_ORBIT_MAINTENANCE: args[0] = burn duration (seconds)
+static void CMD_OrbitMaintenance(const uint8_t *args, uint8_t args_len) {
+    (void)args_len;
+    // Duration and altitude change together or not at all: range-check the
+    // new altitude before either value is stored
+    PARAM_WriteBegin();
+    int32_t altitude = PARAM_Get(PARAM_ALTITUDE) + (int32_t)args[0] * ALTITUDE_GAIN_PER_SEC;
+    bool in_range = (altitude >= PARAM_ALTITUDE_MIN && altitude <= PARAM_ALTITUDE_MAX);
+    if (in_range) {
+        PARAM_Store(PARAM_THRUSTER_DURATION, args[0]);
+        PARAM_Store(PARAM_ALTITUDE, altitude);
+    }
+    PARAM_WriteEnd();
+
+    if (!in_range) {
+        printf("[SUB-SYSTEM] ORBIT: Burn of %d sec rejected, altitude out of range.\n", args[0]);
+        return;
+    }
+    printf("[SUB-SYSTEM] ORBIT: Burn for %d sec. Altitude is now %d meters.\n",
+           args[0], (int)altitude);
+}
+
+// CMD_THERMAL_CONTROL: args[0] = target temperature (signed Celsius)
+static void CMD_ThermalControl(const uint8_t *args, uint8_t args_len) {
+    (void)args_len;
+    PARAM_Set(PARAM_TARGET_TEMP, (int8_t)args[0]);
+    printf("[SUB-SYSTEM] THERMAL: Target temperature set to %d Celsius.\n", (int8_t)args[0]);
+}
+
+void MISSION_RegisterCommands(void) {
+    COMMS_RegisterCommand(CMD_ORBIT_MAINTENANCE, CMD_OrbitMaintenance, 1, 1);
+    COMMS_RegisterCommand(CMD_THERMAL_CONTROL, CMD_ThermalControl, 1, 1);
+}
@@ -1,6 +1,7 @@
 #include <unity.h>
 #include <string.h>
 #include "ccsds_packet.h"
+#include "byte_order.h"
 #include "time_service.h"
 
 void setUp(void) {
@@ -51,9 +52,90 @@ void test_CCSDS_Secondary_Header_Time(void) {
     TEST_ASSERT_EQUAL_HEX8(0x00, buffer[12]);
 }
 
+void test_CCSDS_Unaligned_Header_Access(void) {
+    // Place the packet at an odd offset, as it is inside a comms frame
+    uint8_t raw[128];
+    uint8_t* pkt = &raw[3];
+    uint8_t dummy_payload[] = {0xAB, 0xCD};
+
+    for(int i = 0; i < 0x1234; i++) TIME_Tick1ms();
+    CCSDS_WrapTelemetry(APID_PAYLOAD, dummy_payload, 2, pkt);
+
+    TEST_ASSERT_EQUAL_HEX16(APID_PAYLOAD, CCSDS_GetAPID(pkt));
+    TEST_ASSERT_TRUE(CCSDS_HasSecondaryHeader(pkt));
+    TEST_ASSERT_EQUAL_HEX16(0x1870, BE_Load16(pkt + CCSDS_PACKET_ID_OFFSET));
+    TEST_ASSERT_EQUAL_HEX16(9, BE_Load16(pkt + CCSDS_LENGTH_OFFSET));
+    TEST_ASSERT_EQUAL_UINT64(0x1234, BE_Load64(pkt + CCSDS_MET_OFFSET));
+    TEST_ASSERT_EQUAL_HEX8(0xAB, pkt[CCSDS_HEADERS_SIZE]);
+}
+
+void test_ByteOrder_RoundTrip(void) {
+    uint8_t buf[9];
+
+    BE_Store32(&buf[1], 0x11223344);
+    TEST_ASSERT_EQUAL_HEX8(0x11, buf[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x44, buf[4]);
+    TEST_ASSERT_EQUAL_HEX32(0x11223344, BE_Load32(&buf[1]));
+
+    BE_Store48(&buf[1], 0xAABBCCDDEEFFULL);
+    TEST_ASSERT_EQUAL_HEX8(0xAA, buf[1]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, buf[6]);
+    TEST_ASSERT_TRUE(BE_Load48(&buf[1]) == 0xAABBCCDDEEFFULL);
+
+    BE_Store64(&buf[1], 0x0102030405060708ULL);
+    TEST_ASSERT_EQUAL_HEX8(0x01, buf[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x08, buf[8]);
+    TEST_ASSERT_TRUE(BE_Load64(&buf[1]) == 0x0102030405060708ULL);
+}
+
+void test_CCSDS_ValidateTelecommand_Accepts(void) {
+    uint8_t buffer[64];
+    uint8_t cmd[] = {0xB2, 15};
+    CCSDS_TcView_t view;
+
+    for(int i = 0; i < 42; i++) TIME_Tick1ms();
+    CCSDS_WrapTelemetry(APID_CDHS, cmd, 2, buffer);
+
+    TEST_ASSERT_EQUAL_INT(CCSDS_TC_OK, CCSDS_ValidateTelecommand(buffer, CCSDS_HEADERS_SIZE + 2, &view));
+    TEST_ASSERT_EQUAL_HEX16(APID_CDHS, view.apid);
+    TEST_ASSERT_EQUAL_UINT8(CCSDS_SEQ_UNSEGMENTED, view.seq_flags);
+    TEST_ASSERT_TRUE(view.has_sec_hdr);
+    TEST_ASSERT_EQUAL_UINT64(42, view.mission_time);
+    TEST_ASSERT_EQUAL_PTR(&buffer[CCSDS_HEADERS_SIZE], view.app_data);
+    TEST_ASSERT_EQUAL_UINT16(2, view.app_data_len);
+}
+
+void test_CCSDS_ValidateTelecommand_Rejects(void) {
+    uint8_t buffer[64];
+    uint8_t cmd[] = {0xB2, 15};
+    uint16_t len = CCSDS_HEADERS_SIZE + 2;
+
+    CCSDS_WrapTelemetry(APID_CDHS, cmd, 2, buffer);
+
+    // Frame length disagrees with the Packet Length field
+    TEST_ASSERT_EQUAL_INT(CCSDS_TC_ERR_LENGTH, CCSDS_ValidateTelecommand(buffer, len + 1, NULL));
+    TEST_ASSERT_EQUAL_INT(CCSDS_TC_ERR_SHORT, CCSDS_ValidateTelecommand(buffer, 3, NULL));
+
+    // Type bit cleared (telemetry)
+    buffer[0] &= ~0x10;
+    TEST_ASSERT_EQUAL_INT(CCSDS_TC_ERR_TYPE, CCSDS_ValidateTelecommand(buffer, len, NULL));
+
+    // Version 1, which is also reported before the type error
+    buffer[0] |= 0x20;
+    TEST_ASSERT_EQUAL_INT(CCSDS_TC_ERR_VERSION, CCSDS_ValidateTelecommand(buffer, len, NULL));
+
+    // Idle APID is never a telecommand
+    CCSDS_WrapTelemetry(APID_IDLE, cmd, 2, buffer);
+    TEST_ASSERT_EQUAL_INT(CCSDS_TC_ERR_APID, CCSDS_ValidateTelecommand(buffer, len, NULL));
+}
+
 int main(void) {
     UNITY_BEGIN();
     RUN_TEST(test_CCSDS_Wrap_Header_Logic);
     RUN_TEST(test_CCSDS_Secondary_Header_Time);
+    RUN_TEST(test_CCSDS_Unaligned_Header_Access);
+    RUN_TEST(test_ByteOrder_RoundTrip);
+    RUN_TEST(test_CCSDS_ValidateTelecommand_Accepts);
+    RUN_TEST(test_CCSDS_ValidateTelecommand_Rejects);
     return UNITY_END();
 }
\ No newline at end of file
@@ -0,0 +1,227 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "cfdp.h"
+#include "ccsds_packet.h"
+#include "time_service.h"
+
+#define TEST_FILE_SIZE 10000
+#define MAX_PACKETS    400
+
+// Everything the sender emits, kept in order for the test to replay
+static uint8_t packets[MAX_PACKETS][MAX_PAYLOAD_SIZE];
+static uint16_t packet_len[MAX_PACKETS];
+static int packet_count;
+
+static char work_dir[64];
+static uint8_t file_data[TEST_FILE_SIZE];
+static cfdp_sender_t tx;
+static cfdp_receiver_t rx;
+
+static void Capture_Link(const uint8_t *packet, uint16_t len, void *ctx) {
+    (void)ctx;
+    if (packet_count < MAX_PACKETS) {
+        memcpy(packets[packet_count], packet, len);
+        packet_len[packet_count] = len;
+    }
+    packet_count++;
+}
+
+static void deliver(int i) {
+    CFDP_ReceiverPacket(&rx, packets[i], packet_len[i]);
+}
+
+static void send_all(cfdp_send_config_t *cfg) {
+    TEST_ASSERT_EQUAL_INT(0, CFDP_SenderStart(&tx, cfg));
+    while (CFDP_SenderStep(&tx, 7) < CFDP_TX_DONE) {
+    }
+}
+
+static cfdp_send_config_t memory_config(cfdp_memory_source_t *src, uint32_t size) {
+    cfdp_send_config_t cfg = {
+        .apid = APID_PAYLOAD, .source_id = 1, .dest_id = 2, .transaction = 7,
+        .source_name = "img_0042.raw", .dest_name = "thumb.raw", .file_size = size,
+        .read = CFDP_ReadMemory, .read_ctx = src, .emit = Capture_Link,
+    };
+    src->base = file_data;
+    src->size = size;
+    return cfg;
+}
+
+static void assert_file_matches(const char *path, const uint8_t *expect, size_t len) {
+    static uint8_t got[TEST_FILE_SIZE + 1];
+    FILE *f = fopen(path, "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL_size_t(len, fread(got, 1, sizeof(got), f));
+    fclose(f);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, got, len);
+}
+
+void setUp(void) {
+    TIME_Init();
+    snprintf(work_dir, sizeof(work_dir), "/tmp/cfdp_test_XXXXXX");
+    TEST_ASSERT_NOT_NULL(mkdtemp(work_dir));
+    TEST_ASSERT_EQUAL_INT(0, CFDP_ReceiverInit(&rx, work_dir));
+
+    uint32_t x = 0x12345678u;
+    for (int i = 0; i < TEST_FILE_SIZE; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        file_data[i] = (uint8_t)x;
+    }
+    packet_count = 0;
+}
+
+void tearDown(void) {
+    char path[128];
+    CFDP_ReceiverClose(&rx);
+    snprintf(path, sizeof(path), "%s/thumb.raw", work_dir);
+    unlink(path);
+    snprintf(path, sizeof(path), "%s/source.bin", work_dir);
+    unlink(path);
+    rmdir(work_dir);
+}
+
+void test_CFDP_ChecksumIsPositionalAndOrderFree(void) {
+    const uint8_t five[] = {1, 2, 3, 4, 5};
+    TEST_ASSERT_EQUAL_HEX32(0x01020304u + 0x05000000u, CFDP_Checksum(0, 0, five, 5));
+    TEST_ASSERT_EQUAL_HEX32(0x00010203u + 0x04050000u, CFDP_Checksum(0, 1, five, 5));
+
+    // Odd-sized pieces summed back to front give the whole-file checksum
+    uint32_t whole = CFDP_Checksum(0, 0, file_data, 1001);
+    uint32_t parts = CFDP_Checksum(0, 998, &file_data[998], 3);
+    parts = CFDP_Checksum(parts, 5, &file_data[5], 993);
+    parts = CFDP_Checksum(parts, 0, file_data, 5);
+    TEST_ASSERT_EQUAL_HEX32(whole, parts);
+}
+
+void test_CFDP_FileRoundTripOutOfOrder(void) {
+    char src_path[128];
+    snprintf(src_path, sizeof(src_path), "%s/source.bin", work_dir);
+    FILE *f = fopen(src_path, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    fwrite(file_data, 1, TEST_FILE_SIZE, f);
+    fclose(f);
+
+    // 1. Stream the file from disk in fixed chunks
+    f = fopen(src_path, "rb");
+    cfdp_send_config_t cfg = {
+        .apid = APID_PAYLOAD, .source_id = 1, .dest_id = 2, .transaction = 3,
+        .source_name = "source.bin", .dest_name = "thumb.raw", .file_size = TEST_FILE_SIZE,
+        .read = CFDP_ReadFile, .read_ctx = f, .emit = Capture_Link,
+    };
+    send_all(&cfg);
+    fclose(f);
+
+    int data_pdus = (TEST_FILE_SIZE + CFDP_FILE_DATA_PER_PDU - 1) / CFDP_FILE_DATA_PER_PDU;
+    TEST_ASSERT_EQUAL_INT(CFDP_TX_DONE, tx.state);
+    TEST_ASSERT_EQUAL_INT(data_pdus + 2, packet_count);
+    TEST_ASSERT_EQUAL_HEX16(APID_PAYLOAD, CCSDS_GetAPID(packets[1]));
+    TEST_ASSERT_EQUAL_HEX32(CFDP_Checksum(0, 0, file_data, TEST_FILE_SIZE), tx.checksum);
+
+    // 2. Metadata first, then the data shuffled with EOF somewhere in the middle
+    int order[MAX_PACKETS];
+    for (int i = 0; i < packet_count - 1; i++) order[i] = i + 1;
+    for (int i = packet_count - 2; i > 0; i--) {
+        int j = (int)((uint32_t)(i * 2654435761u) % (uint32_t)(i + 1));
+        int t = order[i]; order[i] = order[j]; order[j] = t;
+    }
+    deliver(0);
+    TEST_ASSERT_EQUAL_INT(CFDP_RX_RECEIVING, rx.state);
+    for (int i = 0; i < packet_count - 1; i++) deliver(order[i]);
+
+    TEST_ASSERT_EQUAL_INT(CFDP_RX_COMPLETE, rx.state);
+    TEST_ASSERT_EQUAL_UINT32(TEST_FILE_SIZE, rx.bytes_received);
+    TEST_ASSERT_EQUAL_UINT16(1, rx.extent_count);
+    TEST_ASSERT_EQUAL_UINT32(0, rx.untracked);
+    CFDP_ReceiverClose(&rx);
+    assert_file_matches(rx.path, file_data, TEST_FILE_SIZE);
+}
+
+void test_CFDP_LostPdusAreReportedAsGaps(void) {
+    cfdp_memory_source_t src;
+    cfdp_send_config_t cfg = memory_config(&src, 1000);
+    cfdp_extent_t gaps[4];
+    send_all(&cfg);
+
+    // 1. Lose File Data PDUs 2, 3 and the last one (packets 3, 4 and count-2)
+    int last_data = packet_count - 2;
+    for (int i = 0; i < packet_count; i++) {
+        if (i != 3 && i != 4 && i != last_data) deliver(i);
+    }
+    TEST_ASSERT_EQUAL_INT(CFDP_RX_INCOMPLETE, rx.state);
+    TEST_ASSERT_EQUAL_INT(2, CFDP_ReceiverGaps(&rx, gaps, 4));
+    TEST_ASSERT_EQUAL_UINT32(2 * CFDP_FILE_DATA_PER_PDU, gaps[0].start);
+    TEST_ASSERT_EQUAL_UINT32(4 * CFDP_FILE_DATA_PER_PDU, gaps[0].end);
+    TEST_ASSERT_EQUAL_UINT32((last_data - 1) * CFDP_FILE_DATA_PER_PDU, gaps[1].start);
+    TEST_ASSERT_EQUAL_UINT32(1000, gaps[1].end);
+
+    // 2. Late arrivals after EOF still fill the holes
+    deliver(4);
+    deliver(last_data);
+    TEST_ASSERT_EQUAL_INT(1, CFDP_ReceiverGaps(&rx, gaps, 4));
+    deliver(3);
+    TEST_ASSERT_EQUAL_INT(0, CFDP_ReceiverGaps(&rx, gaps, 4));
+    TEST_ASSERT_EQUAL_INT(CFDP_RX_COMPLETE, rx.state);
+    CFDP_ReceiverClose(&rx);
+    assert_file_matches(rx.path, file_data, 1000);
+}
+
+void test_CFDP_DuplicatesAndCorruption(void) {
+    cfdp_memory_source_t src;
+    cfdp_send_config_t cfg = memory_config(&src, 500);
+    send_all(&cfg);
+
+    // 1. A repeated PDU is written again but counted once
+    for (int i = 0; i < packet_count - 1; i++) deliver(i);
+    deliver(2);
+    deliver(packet_count - 1);
+    TEST_ASSERT_EQUAL_INT(CFDP_RX_COMPLETE, rx.state);
+    TEST_ASSERT_EQUAL_UINT32(CFDP_FILE_DATA_PER_PDU, rx.duplicate_bytes);
+
+    // 2. Same transfer again with one payload byte flipped in transit
+    CFDP_ReceiverClose(&rx);
+    CFDP_ReceiverInit(&rx, work_dir);
+    packets[3][CCSDS_HEADERS_SIZE + CFDP_PDU_HEADER_SIZE + 4 + 10] ^= 0x40;
+    for (int i = 0; i < packet_count; i++) deliver(i);
+    TEST_ASSERT_EQUAL_INT(CFDP_RX_CHECKSUM_FAILED, rx.state);
+
+    // 3. Data for some other transaction, or a path as dest name, is refused
+    uint32_t rejected = rx.rejected;
+    cfg.transaction = 8;
+    cfg.dest_name = "../escape";
+    packet_count = 0;
+    send_all(&cfg);
+    for (int i = 0; i < packet_count; i++) deliver(i);
+    TEST_ASSERT_EQUAL_UINT32(rejected + (uint32_t)packet_count, rx.rejected);
+}
+
+void test_CFDP_ShortSourceEndsWithSizeError(void) {
+    cfdp_memory_source_t src;
+    cfdp_send_config_t cfg = memory_config(&src, 1000);
+    cfdp_pdu_t eof;
+
+    src.size = 100;   // File shrank after Metadata announced 1000 bytes
+    send_all(&cfg);
+    TEST_ASSERT_EQUAL_INT(CFDP_TX_ERROR, tx.state);
+    TEST_ASSERT_EQUAL_UINT32(100, tx.offset);
+
+    TEST_ASSERT_EQUAL_INT(0, CFDP_DecodePdu(packets[packet_count - 1] + CCSDS_HEADERS_SIZE,
+                                            (uint16_t)(packet_len[packet_count - 1] - CCSDS_HEADERS_SIZE), &eof));
+    TEST_ASSERT_EQUAL_INT(CFDP_PDU_EOF, eof.type);
+    TEST_ASSERT_EQUAL_HEX8(CFDP_COND_FILE_SIZE_ERROR, eof.condition);
+
+    for (int i = 0; i < packet_count; i++) deliver(i);
+    TEST_ASSERT_EQUAL_INT(CFDP_RX_INCOMPLETE, rx.state);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_CFDP_ChecksumIsPositionalAndOrderFree);
+    RUN_TEST(test_CFDP_FileRoundTripOutOfOrder);
+    RUN_TEST(test_CFDP_LostPdusAreReportedAsGaps);
+    RUN_TEST(test_CFDP_DuplicatesAndCorruption);
+    RUN_TEST(test_CFDP_ShortSourceEndsWithSizeError);
+    return UNITY_END();
+}
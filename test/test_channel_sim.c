@@ -0,0 +1,82 @@
+#include <unity.h>
+#include <string.h>
+#include "channel_sim.h"
+
+#define STREAM_LEN 200000
+
+static uint8_t tx[STREAM_LEN];
+static uint8_t rx[STREAM_LEN * 2];
+static uint8_t rx2[STREAM_LEN * 2];
+
+void setUp(void) {
+    for (size_t i = 0; i < STREAM_LEN; i++) tx[i] = (uint8_t)(i * 37u);
+}
+
+void tearDown(void) {}
+
+void test_CHSIM_CleanChannelIsTransparent(void) {
+    chsim_channel_t ch;
+    chsim_config_t cfg = { .seed = 1 };
+    CHSIM_Init(&ch, &cfg);
+
+    TEST_ASSERT_EQUAL_UINT32(STREAM_LEN, CHSIM_Transmit(&ch, tx, STREAM_LEN, rx, sizeof(rx)));
+    TEST_ASSERT_EQUAL_MEMORY(tx, rx, STREAM_LEN);
+}
+
+void test_CHSIM_SameSeedSameErrors(void) {
+    chsim_channel_t a, b;
+    chsim_config_t cfg = { .seed = 42, .ber = 1e-3, .drop_prob = 1e-4, .insert_prob = 1e-4,
+                           .dropout_prob = 1e-4, .dropout_len = 50 };
+    CHSIM_Init(&a, &cfg);
+    CHSIM_Init(&b, &cfg);
+
+    size_t na = CHSIM_Transmit(&a, tx, STREAM_LEN, rx, sizeof(rx));
+    size_t nb = CHSIM_Transmit(&b, tx, STREAM_LEN, rx2, sizeof(rx2));
+    TEST_ASSERT_EQUAL_UINT32(na, nb);
+    TEST_ASSERT_EQUAL_MEMORY(rx, rx2, na);
+
+    chsim_stats_t st;
+    CHSIM_GetStats(&a, &st);
+    TEST_ASSERT_EQUAL_UINT64(STREAM_LEN - st.bytes_dropped + st.bytes_inserted, na);
+    TEST_ASSERT_TRUE(st.bytes_inserted > 0 && st.dropouts > 0);
+}
+
+void test_CHSIM_MeasuredBerMatchesConfig(void) {
+    chsim_channel_t ch;
+    chsim_config_t cfg = { .seed = 7, .ber = 1e-3 };
+    CHSIM_Init(&ch, &cfg);
+    CHSIM_Transmit(&ch, tx, STREAM_LEN, rx, sizeof(rx));
+
+    // 1.6 Mbit at 1e-3: expect 1600 flips, sigma ~40
+    uint32_t flips = 0;
+    for (size_t i = 0; i < STREAM_LEN; i++) flips += (uint32_t)__builtin_popcount(tx[i] ^ rx[i]);
+    TEST_ASSERT_UINT32_WITHIN(200, 1600, flips);
+}
+
+void test_CHSIM_GilbertElliottErrorsCluster(void) {
+    chsim_channel_t ch;
+    // Same long-run BER as 1e-3 but concentrated in bad-state bursts
+    chsim_config_t cfg = { .seed = 9, .burst = true, .ge_p_good_to_bad = 1e-4,
+                           .ge_p_bad_to_good = 0.01, .ge_ber_good = 0.0, .ge_ber_bad = 0.1 };
+    CHSIM_Init(&ch, &cfg);
+    CHSIM_Transmit(&ch, tx, STREAM_LEN, rx, sizeof(rx));
+
+    uint32_t bad_bytes = 0, bad_after_bad = 0;
+    for (size_t i = 1; i < STREAM_LEN; i++) {
+        bool bad = tx[i] != rx[i];
+        bad_bytes += bad;
+        bad_after_bad += bad && tx[i - 1] != rx[i - 1];
+    }
+    TEST_ASSERT_TRUE(bad_bytes > 100);
+    // Independent errors would give P(bad | previous bad) ~ 1%; bursts far more
+    TEST_ASSERT_TRUE(bad_after_bad * 4 > bad_bytes);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_CHSIM_CleanChannelIsTransparent);
+    RUN_TEST(test_CHSIM_SameSeedSameErrors);
+    RUN_TEST(test_CHSIM_MeasuredBerMatchesConfig);
+    RUN_TEST(test_CHSIM_GilbertElliottErrorsCluster);
+    return UNITY_END();
+}
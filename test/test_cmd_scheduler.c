@@ -0,0 +1,160 @@
+#include <unity.h>
+#include <string.h>
+#include <stdlib.h>
+#include "comms_frame.h"
+#include "cmd_scheduler.h"
+#include "byte_order.h"
+#include "time_service.h"
+
+// Records the argument byte of every released test command, in order
+#define TEST_CMD 0x55
+static uint8_t released_args[SCHED_CAPACITY];
+static int released_count = 0;
+
+static void Test_Handler(const uint8_t *args, uint8_t args_len) {
+    (void)args_len;
+    released_args[released_count++] = args[0];
+}
+
+void setUp(void) {
+    TIME_Init();
+    SCHED_Init();
+    COMMS_RegisterCommand(TEST_CMD, Test_Handler, 1, 1);
+    released_count = 0;
+}
+
+void tearDown(void) {}
+
+static sched_id_t schedule(uint64_t met, uint8_t arg) {
+    uint8_t cmd[] = {TEST_CMD, arg};
+    return SCHED_Insert(met, cmd, sizeof(cmd));
+}
+
+static void advance_ms(int ms) {
+    for (int i = 0; i < ms; i++) TIME_Tick1ms();
+}
+
+void test_SCHED_ReleasesInTimeOrderOnTick(void) {
+    schedule(30, 3);
+    schedule(10, 1);
+    schedule(20, 2);
+    schedule(10, 4);   // Same time as arg 1: runs after it
+
+    TEST_ASSERT_EQUAL_UINT64(10, SCHED_PeekNextTime());
+    TEST_ASSERT_EQUAL_INT(0, SCHED_Tick());
+
+    advance_ms(10);
+    TEST_ASSERT_EQUAL_INT(2, SCHED_Tick());
+    TEST_ASSERT_EQUAL_UINT8(1, released_args[0]);
+    TEST_ASSERT_EQUAL_UINT8(4, released_args[1]);
+    TEST_ASSERT_EQUAL_UINT64(20, SCHED_PeekNextTime());
+
+    advance_ms(25);
+    TEST_ASSERT_EQUAL_INT(2, SCHED_Tick());
+    TEST_ASSERT_EQUAL_UINT8(2, released_args[2]);
+    TEST_ASSERT_EQUAL_UINT8(3, released_args[3]);
+    TEST_ASSERT_TRUE(SCHED_PeekNextTime() == SCHED_NO_COMMAND);
+}
+
+void test_SCHED_CancelRemovesOnlyThatCommand(void) {
+    schedule(5, 1);
+    sched_id_t burn = schedule(6, 2);
+    schedule(7, 3);
+
+    TEST_ASSERT_TRUE(SCHED_Cancel(burn));
+    TEST_ASSERT_FALSE(SCHED_Cancel(burn));   // Stale handle
+    TEST_ASSERT_EQUAL_UINT16(2, SCHED_Count());
+
+    advance_ms(10);
+    SCHED_Tick();
+    TEST_ASSERT_EQUAL_INT(2, released_count);
+    TEST_ASSERT_EQUAL_UINT8(1, released_args[0]);
+    TEST_ASSERT_EQUAL_UINT8(3, released_args[1]);
+}
+
+void test_SCHED_UplinkedTimeTaggedCommand(void) {
+    comms_frame_t frame;
+    uint8_t uplink[11];
+
+    // [CMD_TIME_TAGGED][MET = 50 ms][TEST_CMD][arg]
+    uplink[0] = CMD_TIME_TAGGED;
+    BE_Store64(&uplink[1], 50);
+    uplink[9] = TEST_CMD;
+    uplink[10] = 0x77;
+    COMMS_CreateFrame(&frame, uplink, sizeof(uplink));
+    COMMS_DispatchCommand(&frame);
+
+    TEST_ASSERT_EQUAL_UINT16(1, SCHED_Count());
+    TEST_ASSERT_EQUAL_INT(0, released_count);
+
+    advance_ms(50);
+    SCHED_Tick();
+    TEST_ASSERT_EQUAL_INT(1, released_count);
+    TEST_ASSERT_EQUAL_UINT8(0x77, released_args[0]);
+}
+
+void test_SCHED_FullCapacityStaysOrdered(void) {
+    static sched_id_t ids[SCHED_CAPACITY];
+    int cancelled = 0;
+
+    srand(1234);
+    for (int i = 0; i < SCHED_CAPACITY; i++) {
+        ids[i] = schedule((uint64_t)(rand() % 1000), (uint8_t)i);
+        TEST_ASSERT_TRUE(ids[i] >= 0);
+    }
+    TEST_ASSERT_EQUAL_INT(-1, schedule(1, 0));
+
+    // Cancel entries scattered through the heap, then drain everything
+    for (int i = 0; i < SCHED_CAPACITY; i += 7) {
+        TEST_ASSERT_TRUE(SCHED_Cancel(ids[i]));
+        cancelled++;
+    }
+
+    uint64_t last = 0;
+    int drained = 0;
+    while (SCHED_Count() > 0) {
+        uint64_t t = SCHED_PeekNextTime();
+        TEST_ASSERT_TRUE(t >= last);
+        last = t;
+        while (TIME_GetMilliseconds() < t) TIME_Tick1ms();
+        drained += SCHED_Tick();
+    }
+    TEST_ASSERT_EQUAL_INT(SCHED_CAPACITY - cancelled, drained);
+}
+
+void test_SCHED_UplinkRejectedWhenFullIsCounted(void) {
+    comms_frame_t frame;
+    uint8_t uplink[11] = {CMD_TIME_TAGGED, 0, 0, 0, 0, 0, 0, 0, 50, TEST_CMD, 0x77};
+    sched_stats_t stats;
+
+    for (int i = 0; i < SCHED_CAPACITY; i++) {
+        TEST_ASSERT_TRUE(schedule(100, (uint8_t)i) >= 0);
+    }
+
+    // The wrapper ran but nothing was stored: only the counter says so
+    COMMS_CreateFrame(&frame, uplink, sizeof(uplink));
+    COMMS_DispatchCommand(&frame);
+    TEST_ASSERT_EQUAL_UINT16(SCHED_CAPACITY, SCHED_Count());
+    SCHED_GetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(SCHED_CAPACITY, stats.inserted);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.rejected);
+
+    // Once there is room the same uplink is stored again
+    advance_ms(100);
+    TEST_ASSERT_EQUAL_INT(SCHED_CAPACITY, SCHED_Tick());
+    COMMS_DispatchCommand(&frame);
+    SCHED_GetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(SCHED_CAPACITY, stats.released);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.rejected);
+    TEST_ASSERT_EQUAL_UINT16(1, SCHED_Count());
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_SCHED_ReleasesInTimeOrderOnTick);
+    RUN_TEST(test_SCHED_CancelRemovesOnlyThatCommand);
+    RUN_TEST(test_SCHED_UplinkedTimeTaggedCommand);
+    RUN_TEST(test_SCHED_FullCapacityStaysOrdered);
+    RUN_TEST(test_SCHED_UplinkRejectedWhenFullIsCounted);
+    return UNITY_END();
+}
@@ -1,6 +1,11 @@
 #include "unity.h"
 #include "../include/comms_frame.h"
+#include "mission_commands.h"
+#include "ccsds_packet.h"
+#include "param_db.h"
+#include "hk_schema.h"
 #include <stdint.h>
+#include <string.h>
 
 void setUp(void) {
     // This runs before every test
@@ -51,6 +56,17 @@ void test_CreateFrame_Basic(void){
     TEST_ASSERT_EQUAL_HEX16(0x246B, frame.crc);
 }
 
+void test_Frame_SerializeMatchesWireLayout(void) {
+    comms_frame_t frame;
+    uint8_t cmd_data[] = {0x01, 0x02, 0x03};
+    uint8_t wire[MAX_FRAME_SIZE];
+    COMMS_CreateFrame(&frame, cmd_data, 3);
+
+    TEST_ASSERT_EQUAL_UINT16(7, COMMS_SerializeFrame(&frame, wire));
+    uint8_t expect[] = {0xAA, 0x03, 0x01, 0x02, 0x03, (uint8_t)(frame.crc >> 8), (uint8_t)frame.crc};
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expect, wire, sizeof(expect));
+}
+
 void test_Parser_FindsFrameInNoise(void) {
     COMMS_ResetParser();
     
@@ -65,7 +81,7 @@ void test_Parser_FindsFrameInNoise(void) {
     uint8_t stream[] = {0xFF, 0x00, 0xAA, 0x03, 0x01, 0x02, 0x03, hi, lo, 0xEE};
     
     int found = 0;
-    for(int i = 0; i < sizeof(stream); i++) {
+    for(int i = 0; i < (int)sizeof(stream); i++) {
         if(COMMS_ParseByte(stream[i]) == 1) {
             found = 1;
         }
@@ -75,79 +91,233 @@ void test_Parser_FindsFrameInNoise(void) {
 
 
 
+// Mission commands arrive as CCSDS telecommands for CDHS; on the ground
+// test bench the route hook hands them straight to the dispatcher.
+static void mission_route(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view) {
+    (void)packet;
+    (void)len;
+    COMMS_DispatchTelecommand(view);
+}
+
+static void uplink_mission_command(const uint8_t *cmd, uint8_t cmd_len, uint16_t seq) {
+    uint8_t pkt[CCSDS_HEADERS_SIZE + 8];
+    comms_frame_t tx_frame;
+    uint8_t wire[MAX_FRAME_SIZE];
+
+    CCSDS_BuildHeaders(pkt, APID_CDHS, (uint16_t)(0xC000 | seq), cmd_len, 0);
+    memcpy(&pkt[CCSDS_HEADERS_SIZE], cmd, cmd_len);
+    COMMS_CreateFrame(&tx_frame, pkt, (uint8_t)(CCSDS_HEADERS_SIZE + cmd_len));
+
+    // Bytes as they come off the radio
+    uint16_t wire_len = COMMS_SerializeFrame(&tx_frame, wire);
+    for (int i = 0; i < wire_len; i++) {
+        COMMS_ParseByte(wire[i]);
+    }
+}
+
 void test_Mission_ThermalUpdate(void) {
     COMMS_ResetParser();
-    
-    // 1. Create a "Set Heater to 15C" command
-    // Payload[0] = Command ID (0xB2)
-    // Payload[1] = Target Temp (15)
+    COMMS_ResetReplayWindows();
+    COMMS_SetRouteHandler(mission_route);
+    MISSION_RegisterCommands();
+
+    // 1. "Set Heater to 15C": Command ID (0xB2), Target Temp (15)
     uint8_t thermal_cmd[] = {CMD_THERMAL_CONTROL, 15};
-    comms_frame_t tx_frame;
-    COMMS_CreateFrame(&tx_frame, thermal_cmd, 2);
-    
+
     // 2. Stream it through the radio
-    uint8_t hi = (uint8_t)(tx_frame.crc >> 8);
-    uint8_t lo = (uint8_t)(tx_frame.crc & 0xFF);
-    uint8_t stream[] = {tx_frame.start_byte, tx_frame.length, 
-                        thermal_cmd[0], thermal_cmd[1], 
-                        hi, lo};
-    
-    // 3. Parser hears the bytes
-    for(int i = 0; i < (int)sizeof(stream); i++) {
-    COMMS_ParseByte(stream[i]);
-}
-    
-    // 4. VERIFY: Did the satellite's target temperature change?
-    TEST_ASSERT_EQUAL_INT8(15, g_target_temperature);
+    uplink_mission_command(thermal_cmd, sizeof(thermal_cmd), 1);
+    COMMS_SetRouteHandler(NULL);
+
+    // 3. VERIFY: Did the satellite's target temperature change?
+    TEST_ASSERT_EQUAL_INT8(15, PARAM_Get(PARAM_TARGET_TEMP));
 }
 
 void test_Mission_OrbitBurn(void) {
     COMMS_ResetParser();
-    
+    COMMS_ResetReplayWindows();
+    COMMS_SetRouteHandler(mission_route);
+    MISSION_RegisterCommands();
+    PARAM_ResetDefaults();
+
     // Initial State Check
-    printf("\n[TEST] Starting Altitude: %u meters\n", g_satellite_altitude);
-    
-    // Create Command: ID 0xA1 (Orbit), Duration 10 seconds
-    uint8_t orbit_cmd[] = {CMD_ORBIT_MAINTENANCE, 10}; 
-    comms_frame_t tx_frame;
-    COMMS_CreateFrame(&tx_frame, orbit_cmd, 2);
-    
-    // Pack the stream
-    uint8_t hi = (uint8_t)(tx_frame.crc >> 8);
-    uint8_t lo = (uint8_t)(tx_frame.crc & 0xFF);
-    uint8_t stream[] = {0xAA, 0x02, 0xA1, 10, hi, lo};
-    
-    // Feed the parser
-    for(int i = 0; i < (int)sizeof(stream); i++) {
-        COMMS_ParseByte(stream[i]);
-    }
-    
+    printf("\n[TEST] Starting Altitude: %d meters\n", PARAM_Get(PARAM_ALTITUDE));
+
+    // Command: ID 0xA1 (Orbit), Duration 10 seconds
+    uint8_t orbit_cmd[] = {CMD_ORBIT_MAINTENANCE, 10};
+    uplink_mission_command(orbit_cmd, sizeof(orbit_cmd), 2);
+    COMMS_SetRouteHandler(NULL);
+
     // VERIFY: 10 seconds of burn * 100m = 1000m gain
     // 500,000 + 1,000 = 501,000
-    printf("[TEST] Ending Altitude:   %u meters\n", g_satellite_altitude);
-    TEST_ASSERT_EQUAL_UINT32(501000, g_satellite_altitude);
+    printf("[TEST] Ending Altitude:   %d meters\n", PARAM_Get(PARAM_ALTITUDE));
+    TEST_ASSERT_EQUAL_UINT32(501000, PARAM_Get(PARAM_ALTITUDE));
+}
+
+void test_Mission_OutOfRangeBurnChangesNothing(void) {
+    COMMS_ResetParser();
+    COMMS_ResetReplayWindows();
+    COMMS_SetRouteHandler(mission_route);
+    MISSION_RegisterCommands();
+    PARAM_ResetDefaults();
+
+    // 1. 250 s would climb 25,000 m past the top of the altitude range
+    PARAM_Set(PARAM_THRUSTER_DURATION, 3);
+    PARAM_Set(PARAM_ALTITUDE, PARAM_INFO[PARAM_ALTITUDE].max - 1000);
+    param_snapshot_t before, after;
+    PARAM_Snapshot(&before);
+
+    uint8_t orbit_cmd[] = {CMD_ORBIT_MAINTENANCE, 250};
+    uplink_mission_command(orbit_cmd, sizeof(orbit_cmd), 3);
+    COMMS_SetRouteHandler(NULL);
+
+    // 2. Neither the burn duration nor the altitude was published
+    PARAM_Snapshot(&after);
+    TEST_ASSERT_TRUE(after.version > before.version);   // The handler did run
+    TEST_ASSERT_EQUAL_INT32(3, after.v[PARAM_THRUSTER_DURATION]);
+    TEST_ASSERT_EQUAL_INT32(PARAM_INFO[PARAM_ALTITUDE].max - 1000, after.v[PARAM_ALTITUDE]);
 }
 
 void test_Mission_TelemetryDownlink(void) {
     // 1. Setup a specific state
-    g_target_temperature = -5;
-    g_satellite_altitude = 505000;
+    PARAM_Set(PARAM_TARGET_TEMP, -5);
+    PARAM_Set(PARAM_ALTITUDE, 505000);
     
     comms_frame_t tl_frame;
+    hk_values_t hk;
     COMMS_GenerateTelemetry(&tl_frame);
     
-    // 2. Verify the ID and Data
-    TEST_ASSERT_EQUAL_INT8(-5, (int8_t)tl_frame.payload[0]);
-    
-    // 3. Reconstruct the 32-bit altitude from the payload bytes
-    uint32_t received_alt = ((uint32_t)tl_frame.payload[1] << 24) |
-                            ((uint32_t)tl_frame.payload[2] << 16) |
-                            ((uint32_t)tl_frame.payload[3] << 8)  |
-                            ((uint32_t)tl_frame.payload[4]);
-                            
-    TEST_ASSERT_EQUAL_UINT32(505000, received_alt);
-    printf("[GROUND] Telemetry Received: Temp=%dC, Alt=%u m, CRC=0x%04X\n", 
-            (int8_t)tl_frame.payload[0], received_alt, tl_frame.crc);
+    // 2. The payload is one packed housekeeping sample
+    TEST_ASSERT_EQUAL_UINT8(HK_PACKED_BYTES, tl_frame.length);
+    HK_Unpack(tl_frame.payload, &hk);
+    TEST_ASSERT_EQUAL_INT32(-5, hk.TARGET_TEMP);
+    TEST_ASSERT_EQUAL_INT32(505000, hk.ALTITUDE);
+    printf("[GROUND] Telemetry Received: Temp=%dC, Alt=%d m, CRC=0x%04X\n", 
+            (int)hk.TARGET_TEMP, (int)hk.ALTITUDE, tl_frame.crc);
+}
+
+void test_APIDFilter_DefaultsAndRuntimeChanges(void) {
+    // Standard subsystems accepted at boot, idle and unknown APIDs dropped
+    TEST_ASSERT_TRUE(COMMS_IsAPIDAccepted(APID_ADCS));
+    TEST_ASSERT_TRUE(COMMS_IsAPIDAccepted(APID_PAYLOAD));
+    TEST_ASSERT_FALSE(COMMS_IsAPIDAccepted(APID_IDLE));
+    TEST_ASSERT_FALSE(COMMS_IsAPIDAccepted(0x123));
+
+    COMMS_AcceptAPID(0x123);
+    COMMS_AcceptAPID(APID_IDLE);
+    TEST_ASSERT_TRUE(COMMS_IsAPIDAccepted(0x123));
+    TEST_ASSERT_FALSE(COMMS_IsAPIDAccepted(APID_IDLE));
+
+    COMMS_RejectAPID(0x123);
+    COMMS_RejectAPID(APID_EPS);
+    TEST_ASSERT_FALSE(COMMS_IsAPIDAccepted(0x123));
+    TEST_ASSERT_FALSE(COMMS_IsAPIDAccepted(APID_EPS));
+    TEST_ASSERT_TRUE(COMMS_IsAPIDAccepted(APID_ADCS));
+
+    COMMS_AcceptAPID(APID_EPS);
+}
+
+static int test_handler_calls = 0;
+static uint8_t test_handler_last_len = 0;
+
+static void Test_Handler(const uint8_t *args, uint8_t args_len) {
+    (void)args;
+    test_handler_calls++;
+    test_handler_last_len = args_len;
+}
+
+void test_Dispatcher_RegisteredCommandAndLengthCheck(void) {
+    comms_frame_t frame;
+    uint8_t ok_cmd[] = {0x42, 0x01, 0x02};
+    uint8_t long_cmd[] = {0x42, 0x01, 0x02, 0x03, 0x04};
+    uint8_t unknown_cmd[] = {0x43, 0x01};
+
+    test_handler_calls = 0;
+    TEST_ASSERT_EQUAL_INT(0, COMMS_RegisterCommand(0x42, Test_Handler, 1, 3));
+    TEST_ASSERT_EQUAL_INT(-1, COMMS_RegisterCommand(0x44, Test_Handler, 4, 2));
+
+    COMMS_CreateFrame(&frame, ok_cmd, sizeof(ok_cmd));
+    COMMS_DispatchCommand(&frame);
+    TEST_ASSERT_EQUAL_INT(1, test_handler_calls);
+    TEST_ASSERT_EQUAL_UINT8(2, test_handler_last_len);
+
+    // Too many arguments and unregistered IDs never reach a handler
+    COMMS_CreateFrame(&frame, long_cmd, sizeof(long_cmd));
+    COMMS_DispatchCommand(&frame);
+    COMMS_CreateFrame(&frame, unknown_cmd, sizeof(unknown_cmd));
+    COMMS_DispatchCommand(&frame);
+    TEST_ASSERT_EQUAL_INT(1, test_handler_calls);
+
+    COMMS_UnregisterCommand(0x42);
+    COMMS_CreateFrame(&frame, ok_cmd, sizeof(ok_cmd));
+    COMMS_DispatchCommand(&frame);
+    TEST_ASSERT_EQUAL_INT(1, test_handler_calls);
+}
+
+void test_Dispatcher_MissionThermalCommand(void) {
+    comms_frame_t frame;
+    uint8_t thermal_cmd[] = {CMD_THERMAL_CONTROL, (uint8_t)-10};
+
+    MISSION_RegisterCommands();
+    COMMS_CreateFrame(&frame, thermal_cmd, sizeof(thermal_cmd));
+    COMMS_DispatchCommand(&frame);
+
+    TEST_ASSERT_EQUAL_INT8(-10, PARAM_Get(PARAM_TARGET_TEMP));
+}
+
+void test_Replay_SlidingWindow(void) {
+    comms_replay_stats_t stats;
+    COMMS_ResetReplayWindows();
+
+    TEST_ASSERT_TRUE(COMMS_AcceptSequence(APID_CDHS, 100));
+    TEST_ASSERT_FALSE(COMMS_AcceptSequence(APID_CDHS, 100));   // Retransmission
+    TEST_ASSERT_TRUE(COMMS_AcceptSequence(APID_CDHS, 103));
+    TEST_ASSERT_TRUE(COMMS_AcceptSequence(APID_CDHS, 101));    // Late, not yet seen
+    TEST_ASSERT_FALSE(COMMS_AcceptSequence(APID_CDHS, 101));
+    TEST_ASSERT_FALSE(COMMS_AcceptSequence(APID_CDHS, 103 - COMMS_REPLAY_WINDOW));  // Stale
+
+    // Windows are per APID
+    TEST_ASSERT_TRUE(COMMS_AcceptSequence(APID_ADCS, 100));
+
+    // 14-bit wrap-around counts as newer
+    TEST_ASSERT_TRUE(COMMS_AcceptSequence(APID_EPS, 0x3FFE));
+    TEST_ASSERT_TRUE(COMMS_AcceptSequence(APID_EPS, 0x0001));
+    TEST_ASSERT_FALSE(COMMS_AcceptSequence(APID_EPS, 0x3FFE));
+
+    COMMS_GetReplayStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(6, stats.accepted);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.duplicates);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.stale);
+}
+
+static int routed_packets = 0;
+static void Count_Route(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view) {
+    (void)packet; (void)len; (void)view;
+    routed_packets++;
+}
+
+void test_Replay_ParserRoutesRetransmittedFrameOnce(void) {
+    uint8_t pkt[32];
+    uint8_t cmd[] = {CMD_THERMAL_CONTROL, 15};
+    comms_frame_t frame;
+    uint8_t wire[MAX_FRAME_SIZE];
+
+    COMMS_ResetParser();
+    COMMS_ResetReplayWindows();
+    COMMS_SetRouteHandler(Count_Route);
+    routed_packets = 0;
+
+    CCSDS_WrapTelemetry(APID_CDHS, cmd, sizeof(cmd), pkt);
+    COMMS_CreateFrame(&frame, pkt, CCSDS_HEADERS_SIZE + sizeof(cmd));
+    uint16_t wire_len = COMMS_SerializeFrame(&frame, wire);
+
+    // Ground sends the same frame three times; every copy is CRC-valid
+    for (int copy = 0; copy < 3; copy++) {
+        for (int i = 0; i < wire_len - 1; i++) COMMS_ParseByte(wire[i]);
+        TEST_ASSERT_EQUAL_INT(1, COMMS_ParseByte(wire[wire_len - 1]));
+    }
+    TEST_ASSERT_EQUAL_INT(1, routed_packets);
+
+    COMMS_SetRouteHandler(NULL);
 }
 
 int main(void) {
@@ -155,9 +325,16 @@ int main(void) {
     RUN_TEST(test_CRC16_StandardString);
     RUN_TEST(test_CRC16_ShortCommand);
     RUN_TEST(test_CreateFrame_Basic);
+    RUN_TEST(test_Frame_SerializeMatchesWireLayout);
     RUN_TEST(test_Parser_FindsFrameInNoise);
     RUN_TEST(test_Mission_ThermalUpdate);
     RUN_TEST(test_Mission_OrbitBurn);
+    RUN_TEST(test_Mission_OutOfRangeBurnChangesNothing);
     RUN_TEST(test_Mission_TelemetryDownlink);
+    RUN_TEST(test_APIDFilter_DefaultsAndRuntimeChanges);
+    RUN_TEST(test_Dispatcher_RegisteredCommandAndLengthCheck);
+    RUN_TEST(test_Dispatcher_MissionThermalCommand);
+    RUN_TEST(test_Replay_SlidingWindow);
+    RUN_TEST(test_Replay_ParserRoutesRetransmittedFrameOnce);
     return UNITY_END();
 }
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include <unity.h>
+#include <string.h>
+#include "comms_frame.h"
+#include "comms_probe.h"
+#include "ccsds_packet.h"
+#include "byte_order.h"
+
+static int handler_calls;
+
+static void probe_handler(const uint8_t *args, uint8_t args_len) {
+    (void)args;
+    (void)args_len;
+    handler_calls++;
+}
+
+static void probe_route(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view) {
+    (void)packet;
+    (void)len;
+    COMMS_DispatchTelecommand(view);
+}
+
+void setUp(void) {
+    PROBE_Reset();
+    COMMS_ResetParser();
+    COMMS_ResetReplayWindows();
+    COMMS_SetRouteHandler(probe_route);
+    COMMS_RegisterCommand(0x42, probe_handler, 0, 4);
+    handler_calls = 0;
+}
+
+void tearDown(void) {
+    COMMS_SetRouteHandler(NULL);
+    COMMS_UnregisterCommand(0x42);
+}
+
+static void uplink(uint16_t seq) {
+    uint8_t pkt[CCSDS_HEADERS_SIZE + 2];
+    comms_frame_t frame;
+    uint8_t wire[MAX_FRAME_SIZE];
+    CCSDS_BuildHeaders(pkt, APID_CDHS, (uint16_t)(0xC000 | seq), 2, 0);
+    pkt[CCSDS_HEADERS_SIZE] = 0x42;
+    pkt[CCSDS_HEADERS_SIZE + 1] = 7;
+    COMMS_CreateFrame(&frame, pkt, sizeof(pkt));
+
+    uint16_t wire_len = COMMS_SerializeFrame(&frame, wire);
+    for (int i = 0; i < wire_len; i++) COMMS_ParseByte(wire[i]);
+}
+
+void test_PROBE_EveryStageSampledOncePerFrame(void) {
+    probe_hist_t h;
+    for (uint16_t seq = 0; seq < 10; seq++) uplink(seq);
+    TEST_ASSERT_EQUAL_INT(10, handler_calls);
+
+    for (int s = 0; s < PROBE_NUM_STAGES; s++) {
+        PROBE_GetHistogram((probe_stage_t)s, &h);
+        TEST_ASSERT_EQUAL_UINT32(10, h.count);
+    }
+
+    // Total covers every stage from sync to routing
+    probe_hist_t total, crc;
+    PROBE_GetHistogram(PROBE_TOTAL, &total);
+    PROBE_GetHistogram(PROBE_CRC_DONE, &crc);
+    TEST_ASSERT_TRUE(total.max_cycles >= crc.max_cycles);
+    uint32_t sum = 0;
+    for (int b = 0; b < PROBE_BUCKETS; b++) sum += total.buckets[b];
+    TEST_ASSERT_EQUAL_UINT32(10, sum);
+}
+
+void test_PROBE_EncodeWindowAndBadFramesStopEarly(void) {
+    uint8_t out[PROBE_PACKET_BYTES];
+    uplink(1);
+
+    // A frame with a bad CRC reaches CRC_DONE but is never routed
+    COMMS_ParseByte(FRAME_START_BYTE);
+    COMMS_ParseByte(1);
+    COMMS_ParseByte(0x00);
+    COMMS_ParseByte(0x00);
+    COMMS_ParseByte(0x00);
+
+    probe_hist_t crc, routed;
+    PROBE_GetHistogram(PROBE_CRC_DONE, &crc);
+    PROBE_GetHistogram(PROBE_ROUTED, &routed);
+    TEST_ASSERT_EQUAL_UINT32(2, crc.count);
+    TEST_ASSERT_EQUAL_UINT32(1, routed.count);
+
+    TEST_ASSERT_EQUAL_UINT16(PROBE_PACKET_BYTES, PROBE_Encode(PROBE_CRC_DONE, out));
+    TEST_ASSERT_EQUAL_UINT8(PROBE_CRC_DONE, out[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, BE_Load32(&out[2]));
+    TEST_ASSERT_EQUAL_UINT32(crc.max_cycles, BE_Load32(&out[6]));
+    uint32_t in_window = 0;
+    for (int i = 0; i < PROBE_WINDOW; i++) in_window += BE_Load16(&out[10 + 2 * i]);
+    TEST_ASSERT_EQUAL_UINT32(2, in_window);
+}
+
+void test_PROBE_OnlyRoutedFramesSampleHandlerDone(void) {
+    probe_hist_t h;
+    uint8_t cmd[] = {0x42, 7};
+    CCSDS_TcView_t view = { .apid = APID_CDHS, .app_data = cmd, .app_data_len = sizeof(cmd) };
+
+    uplink(1);
+
+    // Direct dispatches (scheduler, workers, ground tools) ran the handler
+    // outside the parser and must not land in the per-frame histograms
+    COMMS_DispatchTelecommand(&view);
+    COMMS_DispatchTelecommand(&view);
+    TEST_ASSERT_EQUAL_INT(3, handler_calls);
+    PROBE_GetHistogram(PROBE_HANDLER_DONE, &h);
+    TEST_ASSERT_EQUAL_UINT32(1, h.count);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_PROBE_EveryStageSampledOncePerFrame);
+    RUN_TEST(test_PROBE_EncodeWindowAndBadFramesStopEarly);
+    RUN_TEST(test_PROBE_OnlyRoutedFramesSampleHandlerDone);
+    return UNITY_END();
+}
@@ -0,0 +1,183 @@
+#include <unity.h>
+#include <string.h>
+#include "ccsds_packet.h"
+#include "downlink_shaper.h"
+#include "frame_pool.h"
+#include "time_service.h"
+
+// The test radio just records which APIDs went out
+static uint16_t tx_apids[64];
+static int tx_count = 0;
+
+static void Test_Radio(const uint8_t *packet, uint16_t len) {
+    (void)len;
+    if (tx_count < 64) tx_apids[tx_count] = CCSDS_GetAPID(packet);
+    tx_count++;
+}
+
+#define PKT_DATA 26
+#define PKT_LEN  (CCSDS_HEADERS_SIZE + PKT_DATA)   // 40 bytes on the link
+
+static int submit(uint16_t apid) {
+    uint8_t data[PKT_DATA] = {0};
+    uint8_t pkt[PKT_LEN];
+    CCSDS_WrapTelemetry(apid, data, PKT_DATA, pkt);
+    return DLS_Submit(pkt, PKT_LEN);
+}
+
+static void advance_ms(int ms) {
+    for (int i = 0; i < ms; i++) TIME_Tick1ms();
+}
+
+void setUp(void) {
+    dls_flow_config_t def = { 1000, 200, 1, DLS_POLICY_DEFER };
+    TIME_Init();
+    DLS_Init(&def, Test_Radio);   // Hands leftover blocks back before the pool reset
+    FPOOL_Reset();
+    tx_count = 0;
+}
+
+void tearDown(void) {}
+
+void test_DLS_HousekeepingKeepsItsShareUnderPayloadFlood(void) {
+    dls_flow_config_t hk = { 400, 80, 1, DLS_POLICY_DEFER };        // 2 packets burst
+    dls_flow_config_t payload = { 400, 80, 1, DLS_POLICY_BORROW };
+    DLS_ConfigureAPID(APID_HK, &hk);
+    DLS_ConfigureAPID(APID_PAYLOAD, &payload);
+
+    // Payload floods first, housekeeping arrives after
+    for (int i = 0; i < DLS_FLOW_DEPTH; i++) submit(APID_PAYLOAD);
+    submit(APID_HK);
+    submit(APID_HK);
+
+    // Link can only take 4 packets: both HK packets make it
+    DLS_Service(4 * PKT_LEN);
+    int hk_sent = 0;
+    for (int i = 0; i < tx_count; i++) hk_sent += (tx_apids[i] == APID_HK);
+    TEST_ASSERT_EQUAL_INT(4, tx_count);
+    TEST_ASSERT_EQUAL_INT(2, hk_sent);
+}
+
+void test_DLS_DeferWaitsForTokensBorrowUsesIdleLink(void) {
+    dls_flow_config_t slow = { 40, PKT_LEN, 1, DLS_POLICY_DEFER };     // 1 packet / s
+    dls_flow_config_t greedy = { 40, PKT_LEN, 1, DLS_POLICY_BORROW };
+    dls_flow_stats_t stats;
+    DLS_ConfigureAPID(APID_EPS, &slow);
+    DLS_ConfigureAPID(APID_PAYLOAD, &greedy);
+
+    submit(APID_EPS);
+    submit(APID_EPS);
+    submit(APID_PAYLOAD);
+    submit(APID_PAYLOAD);
+
+    // One conformant packet each, then only the BORROW flow may go on
+    DLS_Service(1000);
+    TEST_ASSERT_EQUAL_INT(3, tx_count);
+    DLS_GetFlowStats(APID_EPS, &stats);
+    TEST_ASSERT_EQUAL_UINT8(1, stats.queued);
+    DLS_GetFlowStats(APID_PAYLOAD, &stats);
+    TEST_ASSERT_EQUAL_UINT32(PKT_LEN, stats.borrowed_bytes);
+
+    // A second later the deferred EPS packet is conformant again
+    advance_ms(1000);
+    DLS_Service(1000);
+    TEST_ASSERT_EQUAL_INT(4, tx_count);
+    TEST_ASSERT_EQUAL_HEX16(APID_EPS, tx_apids[3]);
+}
+
+void test_DLS_DropPolicyPolicesOnSubmit(void) {
+    dls_flow_config_t policed = { 40, 2 * PKT_LEN, 1, DLS_POLICY_DROP };
+    dls_flow_stats_t stats;
+    DLS_ConfigureAPID(APID_ARCHIVE, &policed);
+
+    TEST_ASSERT_EQUAL_INT(0, submit(APID_ARCHIVE));
+    TEST_ASSERT_EQUAL_INT(0, submit(APID_ARCHIVE));
+    TEST_ASSERT_EQUAL_INT(-1, submit(APID_ARCHIVE));
+
+    DLS_GetFlowStats(APID_ARCHIVE, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.dropped);
+}
+
+void test_DLS_WeightedFairShare(void) {
+    dls_flow_config_t heavy = { 100000, 10000, 3, DLS_POLICY_DEFER };
+    dls_flow_config_t light = { 100000, 10000, 1, DLS_POLICY_DEFER };
+    DLS_ConfigureAPID(APID_ADCS, &heavy);
+    DLS_ConfigureAPID(APID_PAYLOAD, &light);
+
+    for (int i = 0; i < DLS_FLOW_DEPTH; i++) {
+        submit(APID_ADCS);
+        submit(APID_PAYLOAD);
+    }
+
+    // Of the first 8 packets, 6 belong to the weight-3 flow
+    DLS_Service(8 * PKT_LEN);
+    int adcs = 0;
+    for (int i = 0; i < 8; i++) adcs += (tx_apids[i] == APID_ADCS);
+    TEST_ASSERT_EQUAL_INT(6, adcs);
+}
+
+void test_DLS_ReconfigureKeepsQueuedPackets(void) {
+    dls_flow_config_t slow = { 40, PKT_LEN, 1, DLS_POLICY_DEFER };
+    dls_flow_config_t fast = { 4000, 4 * PKT_LEN, 2, DLS_POLICY_DEFER };
+    fpool_stats_t pool;
+    dls_flow_stats_t stats;
+    DLS_ConfigureAPID(APID_EPS, &slow);
+
+    for (int i = 0; i < 4; i++) submit(APID_EPS);
+    FPOOL_GetStats(FPOOL_CLASS_FRAME, &pool);
+    uint32_t queued_blocks = pool.in_use;
+    TEST_ASSERT_EQUAL_UINT32(4, queued_blocks);
+
+    // Reconfiguring under load neither drops nor leaks the queued blocks
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL_INT(0, DLS_ConfigureAPID(APID_EPS, (i & 1) ? &slow : &fast));
+    }
+    DLS_GetFlowStats(APID_EPS, &stats);
+    TEST_ASSERT_EQUAL_UINT8(4, stats.queued);
+    FPOOL_GetStats(FPOOL_CLASS_FRAME, &pool);
+    TEST_ASSERT_EQUAL_UINT32(queued_blocks, pool.in_use);
+
+    // The new rate applies to what is already queued, and every block comes back
+    DLS_ConfigureAPID(APID_EPS, &fast);
+    advance_ms(100);
+    DLS_Service(1000);
+    TEST_ASSERT_EQUAL_INT(4, tx_count);
+    FPOOL_GetStats(FPOOL_CLASS_FRAME, &pool);
+    TEST_ASSERT_EQUAL_UINT32(0, pool.in_use);
+}
+
+void test_DLS_PacketLargerThanBurstIsRefused(void) {
+    dls_flow_config_t small = { 1000, PKT_LEN - 1, 1, DLS_POLICY_DEFER };
+    dls_flow_config_t roomy = { 1000, PKT_LEN, 1, DLS_POLICY_DEFER };
+    dls_flow_config_t borrow = { 1000, PKT_LEN - 1, 1, DLS_POLICY_BORROW };
+    dls_flow_stats_t stats;
+
+    // 1. A DEFER packet the bucket can never pay for is dropped, not queued
+    DLS_ConfigureAPID(APID_EPS, &small);
+    TEST_ASSERT_EQUAL_INT(-1, submit(APID_EPS));
+    DLS_GetFlowStats(APID_EPS, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.dropped);
+    TEST_ASSERT_EQUAL_UINT8(0, stats.queued);
+
+    // 2. Shrinking the burst below a queued packet is refused
+    DLS_ConfigureAPID(APID_EPS, &roomy);
+    TEST_ASSERT_EQUAL_INT(0, submit(APID_EPS));
+    TEST_ASSERT_EQUAL_INT(-1, DLS_ConfigureAPID(APID_EPS, &small));
+
+    // 3. BORROW can still send it on idle capacity
+    TEST_ASSERT_EQUAL_INT(0, DLS_ConfigureAPID(APID_EPS, &borrow));
+    TEST_ASSERT_EQUAL_INT(0, submit(APID_EPS));
+    DLS_Service(1000);
+    TEST_ASSERT_EQUAL_INT(2, tx_count);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_DLS_HousekeepingKeepsItsShareUnderPayloadFlood);
+    RUN_TEST(test_DLS_DeferWaitsForTokensBorrowUsesIdleLink);
+    RUN_TEST(test_DLS_DropPolicyPolicesOnSubmit);
+    RUN_TEST(test_DLS_WeightedFairShare);
+    RUN_TEST(test_DLS_ReconfigureKeepsQueuedPackets);
+    RUN_TEST(test_DLS_PacketLargerThanBurstIsRefused);
+    return UNITY_END();
+}
@@ -0,0 +1,127 @@
+#include <unity.h>
+#include <string.h>
+#include <pthread.h>
+#include "frame_pool.h"
+
+void setUp(void) {
+    FPOOL_Reset();
+}
+
+void tearDown(void) {}
+
+void test_FPOOL_PicksSmallestFittingClass(void) {
+    void *small = FPOOL_Alloc(10);
+    void *frame = FPOOL_Alloc(sizeof(comms_frame_t));
+    void *large = FPOOL_Alloc(300);
+
+    TEST_ASSERT_EQUAL_UINT32(FPOOL_SMALL_BLOCK, FPOOL_BlockSize(small));
+    TEST_ASSERT_EQUAL_UINT32(FPOOL_FRAME_BLOCK, FPOOL_BlockSize(frame));
+    TEST_ASSERT_EQUAL_UINT32(FPOOL_LARGE_BLOCK, FPOOL_BlockSize(large));
+    TEST_ASSERT_NULL(FPOOL_Alloc(FPOOL_LARGE_BLOCK + 1));
+    TEST_ASSERT_EQUAL_UINT32(0, (uintptr_t)frame % 8);
+
+    FPOOL_Free(small);
+    FPOOL_Free(frame);
+    FPOOL_Free(large);
+}
+
+void test_FPOOL_ExhaustionFallbackAndHighWater(void) {
+    void *blocks[FPOOL_LARGE_COUNT + 1];
+    fpool_stats_t stats;
+
+    for (int i = 0; i < FPOOL_LARGE_COUNT; i++) {
+        blocks[i] = FPOOL_Alloc(FPOOL_LARGE_BLOCK);
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+    }
+    TEST_ASSERT_NULL(FPOOL_Alloc(FPOOL_LARGE_BLOCK));
+
+    FPOOL_GetStats(FPOOL_CLASS_LARGE, &stats);
+    TEST_ASSERT_EQUAL_UINT32(FPOOL_LARGE_COUNT, stats.in_use);
+    TEST_ASSERT_EQUAL_UINT32(FPOOL_LARGE_COUNT, stats.high_water);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.failures);
+
+    // Freed blocks are reused; the high-water mark stays
+    FPOOL_Free(blocks[1]);
+    blocks[1] = FPOOL_Alloc(FPOOL_LARGE_BLOCK);
+    TEST_ASSERT_NOT_NULL(blocks[1]);
+    for (int i = 0; i < FPOOL_LARGE_COUNT; i++) FPOOL_Free(blocks[i]);
+    FPOOL_GetStats(FPOOL_CLASS_LARGE, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.in_use);
+    TEST_ASSERT_EQUAL_UINT32(FPOOL_LARGE_COUNT, stats.high_water);
+
+    // A small request overflows into the next class when its own is empty
+    void *small[FPOOL_SMALL_COUNT];
+    for (int i = 0; i < FPOOL_SMALL_COUNT; i++) small[i] = FPOOL_Alloc(1);
+    void *spill = FPOOL_Alloc(1);
+    TEST_ASSERT_EQUAL_UINT32(FPOOL_FRAME_BLOCK, FPOOL_BlockSize(spill));
+    FPOOL_Free(spill);
+    for (int i = 0; i < FPOOL_SMALL_COUNT; i++) FPOOL_Free(small[i]);
+
+    // Foreign pointers are ignored
+    uint8_t not_ours[8];
+    FPOOL_Free(not_ours);
+    FPOOL_GetStats(FPOOL_CLASS_SMALL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.in_use);
+}
+
+// Several threads hammer one class; every block must stay unique
+#define STRESS_THREADS 4
+#define STRESS_ROUNDS  20000
+
+static void *stress_worker(void *arg) {
+    uint8_t tag = (uint8_t)(uintptr_t)arg;
+    for (int i = 0; i < STRESS_ROUNDS; i++) {
+        uint8_t *b = FPOOL_Alloc(FPOOL_LARGE_BLOCK);
+        if (b == NULL) continue;
+        memset(b, tag, 16);
+        for (int k = 0; k < 16; k++) {
+            if (b[k] != tag) return (void *)1;   // Someone else owns our block
+        }
+        FPOOL_Free(b);
+    }
+    return NULL;
+}
+
+void test_FPOOL_DoubleFreeIsIgnored(void) {
+    fpool_stats_t stats;
+    void *a = FPOOL_Alloc(FPOOL_LARGE_BLOCK);
+    FPOOL_Free(a);
+    FPOOL_Free(a);
+
+    // The block went back once: two allocations still get two blocks
+    void *b = FPOOL_Alloc(FPOOL_LARGE_BLOCK);
+    void *c = FPOOL_Alloc(FPOOL_LARGE_BLOCK);
+    TEST_ASSERT_TRUE(b != c);
+    FPOOL_GetStats(FPOOL_CLASS_LARGE, &stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.in_use);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.bad_frees);
+    FPOOL_Free(b);
+    FPOOL_Free(c);
+}
+
+void test_FPOOL_ConcurrentAllocFree(void) {
+    pthread_t threads[STRESS_THREADS];
+    fpool_stats_t stats;
+
+    for (uintptr_t t = 0; t < STRESS_THREADS; t++) {
+        pthread_create(&threads[t], NULL, stress_worker, (void *)(t + 1));
+    }
+    for (int t = 0; t < STRESS_THREADS; t++) {
+        void *result;
+        pthread_join(threads[t], &result);
+        TEST_ASSERT_NULL(result);
+    }
+
+    FPOOL_GetStats(FPOOL_CLASS_LARGE, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.in_use);
+    TEST_ASSERT_TRUE(stats.high_water <= FPOOL_LARGE_COUNT);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_FPOOL_PicksSmallestFittingClass);
+    RUN_TEST(test_FPOOL_ExhaustionFallbackAndHighWater);
+    RUN_TEST(test_FPOOL_DoubleFreeIsIgnored);
+    RUN_TEST(test_FPOOL_ConcurrentAllocFree);
+    return UNITY_END();
+}
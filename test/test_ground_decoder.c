@@ -0,0 +1,142 @@
+#include <unity.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ground_decoder.h"
+#include "comms_frame.h"
+#include "ccsds_packet.h"
+
+#define CAPTURE_SIZE 6000
+#define MAX_EXPECTED 256
+
+static uint8_t capture[CAPTURE_SIZE];
+static uint64_t expected[MAX_EXPECTED];
+static size_t expected_count;
+
+static uint64_t seen[MAX_EXPECTED];
+static size_t seen_count;
+
+void setUp(void) {
+    seen_count = 0;
+}
+
+void tearDown(void) {}
+
+static void collect(void *ctx, const gdec_frame_t *frame, const uint8_t *payload) {
+    (void)ctx;
+    (void)payload;
+    if (seen_count < MAX_EXPECTED) seen[seen_count++] = frame->offset;
+}
+
+static size_t put_frame(size_t pos, const uint8_t *payload, uint8_t len) {
+    comms_frame_t f;
+    COMMS_CreateFrame(&f, payload, len);
+    return pos + COMMS_SerializeFrame(&f, &capture[pos]);
+}
+
+// Noise full of stray start bytes, real frames, and frames whose payload
+// contains another valid frame (which must not be reported)
+static void build_capture(void) {
+    uint32_t lcg = 12345;
+    size_t pos = 0;
+    expected_count = 0;
+
+    while (pos + MAX_PAYLOAD_SIZE + 8 < CAPTURE_SIZE && expected_count < MAX_EXPECTED) {
+        lcg = lcg * 1103515245u + 12345u;
+        unsigned kind = (lcg >> 16) % 4;
+        uint8_t payload[MAX_PAYLOAD_SIZE];
+        uint8_t len = (uint8_t)(8 + (lcg >> 8) % 40);
+
+        for (int i = 0; i < len; i++) {
+            lcg = lcg * 1103515245u + 12345u;
+            payload[i] = (uint8_t)(lcg >> 24);
+        }
+        payload[0] = 0x18;   // APID_CDHS header
+        payload[1] = APID_CDHS;
+
+        if (kind == 0) {
+            // Stray bytes between frames
+            for (int i = 0; i < 7; i++) capture[pos++] = (i & 1) ? FRAME_START_BYTE : payload[i];
+        } else if (kind == 1) {
+            // Outer frame wrapping a valid inner frame
+            comms_frame_t inner;
+            COMMS_CreateFrame(&inner, payload, 6);
+            COMMS_SerializeFrame(&inner, &payload[10]);
+            len = len < 24 ? 24 : len;
+            expected[expected_count++] = pos;
+            pos = put_frame(pos, payload, len);
+        } else {
+            expected[expected_count++] = pos;
+            pos = put_frame(pos, payload, len);
+        }
+    }
+    memset(&capture[pos], FRAME_START_BYTE, CAPTURE_SIZE - pos);
+}
+
+void test_GDEC_SingleThreadFindsFramesOnly(void) {
+    gdec_stats_t stats;
+    build_capture();
+
+    TEST_ASSERT_EQUAL_INT(0, GDEC_DecodeBuffer(capture, CAPTURE_SIZE, 1, collect, NULL, &stats));
+    TEST_ASSERT_EQUAL_UINT32(expected_count, seen_count);
+    TEST_ASSERT_EQUAL_UINT64_ARRAY(expected, seen, expected_count);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.resyncs);
+}
+
+void test_GDEC_AnyThreadCountMatchesSerialOrder(void) {
+    gdec_stats_t stats;
+    uint64_t resyncs = 0;
+    build_capture();
+
+    // Every split puts boundaries somewhere new, including inside frames
+    for (unsigned threads = 2; threads <= GDEC_MAX_THREADS; threads++) {
+        seen_count = 0;
+        TEST_ASSERT_EQUAL_INT(0, GDEC_DecodeBuffer(capture, CAPTURE_SIZE, threads, collect, NULL, &stats));
+        TEST_ASSERT_EQUAL_UINT32(expected_count, seen_count);
+        TEST_ASSERT_EQUAL_UINT64_ARRAY(expected, seen, expected_count);
+        resyncs += stats.resyncs;
+    }
+    TEST_ASSERT_TRUE(resyncs > 0);   // Boundaries did land inside frames
+}
+
+// Order-sensitive digest of every reported offset
+static void digest(void *ctx, const gdec_frame_t *frame, const uint8_t *payload) {
+    uint64_t *d = ctx;
+    (void)payload;
+    d[0]++;
+    d[1] = d[1] * 1099511628211u ^ frame->offset;
+}
+
+void test_GDEC_WindowedCaptureMatchesSerialOrder(void) {
+    size_t big_size = 5 * GDEC_CHUNK_BYTES + 777;
+    uint8_t *big = malloc(big_size);
+    uint64_t serial[2] = {0, 0};
+    gdec_stats_t stats;
+    TEST_ASSERT_NOT_NULL(big);
+    build_capture();
+
+    // Tiles of the test capture, so frames straddle every window edge
+    for (size_t pos = 0; pos < big_size; pos += CAPTURE_SIZE) {
+        size_t n = (big_size - pos < CAPTURE_SIZE) ? big_size - pos : CAPTURE_SIZE;
+        memcpy(&big[pos], capture, n);
+    }
+    TEST_ASSERT_EQUAL_INT(0, GDEC_DecodeBuffer(big, big_size, 1, digest, serial, &stats));
+    TEST_ASSERT_TRUE(serial[0] >= (big_size / CAPTURE_SIZE) * expected_count);
+
+    // 2, 3 and 4 threads take 3, 2 and 2 windows; 7 fit in one
+    unsigned counts[] = {2, 3, 4, 7};
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        uint64_t got[2] = {0, 0};
+        TEST_ASSERT_EQUAL_INT(0, GDEC_DecodeBuffer(big, big_size, counts[i], digest, got, &stats));
+        TEST_ASSERT_EQUAL_UINT64(serial[0], got[0]);
+        TEST_ASSERT_EQUAL_UINT64(serial[1], got[1]);
+    }
+    free(big);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_GDEC_SingleThreadFindsFramesOnly);
+    RUN_TEST(test_GDEC_AnyThreadCountMatchesSerialOrder);
+    RUN_TEST(test_GDEC_WindowedCaptureMatchesSerialOrder);
+    return UNITY_END();
+}
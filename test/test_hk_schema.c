@@ -0,0 +1,208 @@
+#include <unity.h>
+#include <string.h>
+#include "comms_frame.h"
+#include "hk_schema.h"
+#include "param_db.h"
+#include "hk_delta.h"
+#include "time_service.h"
+
+void setUp(void) {
+    TIME_Init();
+}
+
+void tearDown(void) {}
+
+void test_HK_PackUnpackRoundTrip(void) {
+    uint8_t packed[HK_PACKED_BYTES];
+    hk_values_t v;
+
+    PARAM_Set(PARAM_HEATER_STATUS, 1);
+    PARAM_Set(PARAM_THRUSTER_DURATION, 200);
+    PARAM_Set(PARAM_TARGET_TEMP, -40);
+    PARAM_Set(PARAM_ALTITUDE, 505000);
+
+    HK_Pack(packed);
+    HK_Unpack(packed, &v);
+
+    TEST_ASSERT_EQUAL_INT32(1, v.HEATER_STATUS);
+    TEST_ASSERT_EQUAL_INT32(200, v.THRUSTER_DURATION);
+    TEST_ASSERT_EQUAL_INT32(-40, v.TARGET_TEMP);
+    TEST_ASSERT_EQUAL_INT32(505000, v.ALTITUDE);
+}
+
+void test_HK_ParameterLimitsSurvivePacking(void) {
+    uint8_t packed[HK_PACKED_BYTES];
+    hk_values_t v;
+
+    // Every field at the top of its parameter range, then at the bottom
+    PARAM_Set(PARAM_HEATER_STATUS, PARAM_INFO[PARAM_HEATER_STATUS].max);
+    PARAM_Set(PARAM_THRUSTER_DURATION, PARAM_INFO[PARAM_THRUSTER_DURATION].max);
+    PARAM_Set(PARAM_TARGET_TEMP, PARAM_INFO[PARAM_TARGET_TEMP].max);
+    TEST_ASSERT_EQUAL_INT(0, PARAM_Set(PARAM_ALTITUDE, PARAM_INFO[PARAM_ALTITUDE].max));
+    HK_Pack(packed);
+    HK_Unpack(packed, &v);
+    TEST_ASSERT_EQUAL_INT32(1, v.HEATER_STATUS);
+    TEST_ASSERT_EQUAL_INT32(255, v.THRUSTER_DURATION);
+    TEST_ASSERT_EQUAL_INT32(127, v.TARGET_TEMP);
+    TEST_ASSERT_EQUAL_INT32(2000000, v.ALTITUDE);
+    TEST_ASSERT_EQUAL_INT32(2000000, HK_DecodeField(packed, HK_FIELD_ALTITUDE));
+
+    PARAM_Set(PARAM_TARGET_TEMP, PARAM_INFO[PARAM_TARGET_TEMP].min);
+    PARAM_Set(PARAM_ALTITUDE, PARAM_INFO[PARAM_ALTITUDE].min);
+    HK_Pack(packed);
+    HK_Unpack(packed, &v);
+    TEST_ASSERT_EQUAL_INT32(-128, v.TARGET_TEMP);
+    TEST_ASSERT_EQUAL_INT32(0, v.ALTITUDE);
+}
+
+void test_HK_BitPackedLayoutIsSmallerAndMsbFirst(void) {
+    uint8_t packed[HK_PACKED_BYTES];
+
+    // 1 + 8 + 8 + 21 bits = 38 bits -> 5 bytes instead of 7 byte-aligned
+    TEST_ASSERT_EQUAL_INT(38, HK_TOTAL_BITS);
+    TEST_ASSERT_EQUAL_INT(5, HK_PACKED_BYTES);
+    TEST_ASSERT_EQUAL_INT(9, HK_FIELDS[HK_FIELD_TARGET_TEMP].bit_offset);
+
+    PARAM_Set(PARAM_HEATER_STATUS, 1);
+    PARAM_Set(PARAM_THRUSTER_DURATION, 0);
+    PARAM_Set(PARAM_TARGET_TEMP, -128);
+    PARAM_Set(PARAM_ALTITUDE, 0);
+    HK_Pack(packed);
+
+    // Heater flag is the very first bit; everything else is zero
+    TEST_ASSERT_EQUAL_HEX8(0x80, packed[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, packed[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, packed[4]);
+}
+
+void test_HK_GroundTableDecodesEachField(void) {
+    uint8_t packed[HK_PACKED_BYTES];
+
+    PARAM_Set(PARAM_HEATER_STATUS, 0);
+    PARAM_Set(PARAM_THRUSTER_DURATION, 7);
+    PARAM_Set(PARAM_TARGET_TEMP, 21);
+    PARAM_Set(PARAM_ALTITUDE, 499999);
+    HK_Pack(packed);
+
+    TEST_ASSERT_EQUAL_STRING("TARGET_TEMP", HK_FIELDS[HK_FIELD_TARGET_TEMP].name);
+    TEST_ASSERT_EQUAL_STRING("m", HK_FIELDS[HK_FIELD_ALTITUDE].unit);
+    TEST_ASSERT_EQUAL_INT32(7, HK_DecodeField(packed, HK_FIELD_THRUSTER_DURATION));
+    TEST_ASSERT_EQUAL_INT32(21, HK_DecodeField(packed, HK_FIELD_TARGET_TEMP));
+    TEST_ASSERT_EQUAL_INT32(499999, HK_DecodeField(packed, HK_FIELD_ALTITUDE));
+}
+
+void test_HKDelta_KeyframeThenChangedOnly(void) {
+    hk_delta_encoder_t enc;
+    hk_delta_decoder_t dec;
+    hk_values_t v;
+    uint8_t pkt[HK_DELTA_MAX_BYTES];
+    uint32_t raw[HK_NUM_FIELDS];
+
+    HK_DeltaEncoderInit(&enc, 10);
+    HK_DeltaDecoderInit(&dec);
+
+    PARAM_Set(PARAM_HEATER_STATUS, 1);
+    PARAM_Set(PARAM_THRUSTER_DURATION, 5);
+    PARAM_Set(PARAM_TARGET_TEMP, 12);
+    PARAM_Set(PARAM_ALTITUDE, 500000);
+    HK_SampleRaw(raw);
+    uint16_t key_len = HK_DeltaEncode(&enc, raw, pkt);
+    TEST_ASSERT_EQUAL_UINT16(1 + HK_PACKED_BYTES, key_len);
+    TEST_ASSERT_EQUAL_INT(HK_DELTA_OK, HK_DeltaDecode(&dec, pkt, key_len, &v));
+
+    // Nothing changed: just the header and the change codes
+    uint16_t idle_len = HK_DeltaEncode(&enc, raw, pkt);
+    TEST_ASSERT_EQUAL_UINT16(2, idle_len);
+    TEST_ASSERT_EQUAL_INT(HK_DELTA_OK, HK_DeltaDecode(&dec, pkt, idle_len, &v));
+
+    // Altitude drifts down a little: an 8-bit delta, not 21 bits
+    PARAM_Set(PARAM_ALTITUDE, PARAM_Get(PARAM_ALTITUDE) - 37);
+    HK_SampleRaw(raw);
+    uint16_t drift_len = HK_DeltaEncode(&enc, raw, pkt);
+    TEST_ASSERT_EQUAL_UINT16(3, drift_len);
+    TEST_ASSERT_EQUAL_INT(HK_DELTA_OK, HK_DeltaDecode(&dec, pkt, drift_len, &v));
+    TEST_ASSERT_EQUAL_INT32(499963, v.ALTITUDE);
+    TEST_ASSERT_EQUAL_INT32(12, v.TARGET_TEMP);
+
+    // Big jumps fall back to the full value
+    PARAM_Set(PARAM_ALTITUDE, 510000);
+    PARAM_Set(PARAM_HEATER_STATUS, 0);
+    HK_SampleRaw(raw);
+    uint16_t jump_len = HK_DeltaEncode(&enc, raw, pkt);
+    TEST_ASSERT_EQUAL_INT(HK_DELTA_OK, HK_DeltaDecode(&dec, pkt, jump_len, &v));
+    TEST_ASSERT_EQUAL_INT32(510000, v.ALTITUDE);
+    TEST_ASSERT_EQUAL_INT32(0, v.HEATER_STATUS);
+}
+
+void test_HKDelta_LostPacketWaitsForKeyframe(void) {
+    hk_delta_encoder_t enc;
+    hk_delta_decoder_t dec;
+    hk_values_t v;
+    uint8_t pkt[HK_DELTA_MAX_BYTES];
+    uint32_t raw[HK_NUM_FIELDS];
+    uint16_t len;
+
+    HK_DeltaEncoderInit(&enc, 4);
+    HK_DeltaDecoderInit(&dec);
+    PARAM_Set(PARAM_ALTITUDE, 500000);
+
+    // Keyframe, delta (lost), delta, delta, keyframe
+    for (int cycle = 0; cycle < 5; cycle++) {
+        PARAM_Set(PARAM_ALTITUDE, PARAM_Get(PARAM_ALTITUDE) + 10);
+        HK_SampleRaw(raw);
+        len = HK_DeltaEncode(&enc, raw, pkt);
+        if (cycle == 1) continue;
+
+        hk_delta_status_t st = HK_DeltaDecode(&dec, pkt, len, &v);
+        if (cycle == 2 || cycle == 3) {
+            TEST_ASSERT_EQUAL_INT(HK_DELTA_NEED_KEYFRAME, st);
+        } else {
+            TEST_ASSERT_EQUAL_INT(HK_DELTA_OK, st);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, dec.missed);
+    TEST_ASSERT_EQUAL_INT32(500050, v.ALTITUDE);
+}
+
+void test_HKDelta_ReservedCodeIsMalformed(void) {
+    hk_delta_encoder_t enc;
+    hk_delta_decoder_t dec;
+    hk_values_t v;
+    uint8_t pkt[HK_DELTA_MAX_BYTES];
+    uint32_t raw[HK_NUM_FIELDS];
+    uint16_t len;
+
+    HK_DeltaEncoderInit(&enc, 3);
+    HK_DeltaDecoderInit(&dec);
+    PARAM_Set(PARAM_ALTITUDE, 500000);
+    HK_SampleRaw(raw);
+
+    // Keyframe, delta with code 3 in the first field, delta, keyframe
+    for (int cycle = 0; cycle < 4; cycle++) {
+        len = HK_DeltaEncode(&enc, raw, pkt);
+        if (cycle == 1) pkt[1] |= 0xC0;
+
+        hk_delta_status_t st = HK_DeltaDecode(&dec, pkt, len, &v);
+        if (cycle == 1) {
+            TEST_ASSERT_EQUAL_INT(HK_DELTA_MALFORMED, st);
+        } else if (cycle == 2) {
+            TEST_ASSERT_EQUAL_INT(HK_DELTA_NEED_KEYFRAME, st);   // Sync was dropped
+        } else {
+            TEST_ASSERT_EQUAL_INT(HK_DELTA_OK, st);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, dec.missed);   // No cycle gap
+    TEST_ASSERT_EQUAL_INT32(500000, v.ALTITUDE);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_HK_PackUnpackRoundTrip);
+    RUN_TEST(test_HK_ParameterLimitsSurvivePacking);
+    RUN_TEST(test_HK_BitPackedLayoutIsSmallerAndMsbFirst);
+    RUN_TEST(test_HK_GroundTableDecodesEachField);
+    RUN_TEST(test_HKDelta_KeyframeThenChangedOnly);
+    RUN_TEST(test_HKDelta_LostPacketWaitsForKeyframe);
+    RUN_TEST(test_HKDelta_ReservedCodeIsMalformed);
+    return UNITY_END();
+}
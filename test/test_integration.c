@@ -3,6 +3,7 @@
 #include <stdio.h>
 #include "comms_frame.h"
 #include "ccsds_packet.h"
+#include "byte_order.h"
 #include "cdhs_router.h"
 #include "time_service.h"
 #include "tm_manager.h"
@@ -25,6 +26,7 @@ void COMMS_CreateFrame_IntegrationHelper(uint8_t* payload, uint8_t len, uint8_t*
 void setUp(void) {
     TIME_Init();
     COMMS_ResetParser();
+    COMMS_ResetReplayWindows();
 }
 
 void tearDown(void) {}
@@ -66,13 +68,12 @@ void Simulate_Ground_Station(uint8_t* rx, uint16_t len) {
         printf("EARTH: CRC Valid! ✅\n");
         
         // Extract Time from CCSDS (offset 2 for frame, offset 6 for CCSDS Sec Header)
-        uint64_t* raw_time = (uint64_t*)&rx[2 + 6];
-        uint64_t sat_time = __builtin_bswap64(*raw_time);
+        uint64_t sat_time = BE_Load64(&rx[2 + CCSDS_MET_OFFSET]);
         
         // Extract APID
         uint16_t apid = CCSDS_GetAPID(&rx[2]);
 
-        printf("EARTH: Satellite Time: %llu ms\n", sat_time);
+        printf("EARTH: Satellite Time: %llu ms\n", (unsigned long long)sat_time);
         printf("EARTH: Subsystem ID: 0x%03X\n", apid);
     } else {
         printf("EARTH: CRC Error! Packet discarded. ❌\n");
@@ -0,0 +1,106 @@
+#include <unity.h>
+#include <string.h>
+#include "ccsds_packet.h"
+#include "packet_bus.h"
+#include "frame_pool.h"
+#include "time_service.h"
+
+// Each test subscriber remembers the last handle it was given
+typedef struct {
+    pbus_buffer_t *held;
+    int calls;
+    int release_now;
+} test_sub_t;
+
+static void Test_Subscriber(pbus_buffer_t *buf, void *ctx) {
+    test_sub_t *s = (test_sub_t *)ctx;
+    s->held = buf;
+    s->calls++;
+    if (s->release_now) PBUS_Release(buf);
+}
+
+void setUp(void) {
+    TIME_Init();
+    FPOOL_Reset();
+    PBUS_Init();
+}
+
+void tearDown(void) {}
+
+static uint16_t build_packet(uint16_t apid, uint8_t *out) {
+    uint8_t data[] = {0x11, 0x22, 0x33};
+    CCSDS_WrapTelemetry(apid, data, sizeof(data), out);
+    return CCSDS_HEADERS_SIZE + sizeof(data);
+}
+
+void test_PBUS_FanOutSharesOneBuffer(void) {
+    uint8_t pkt[32];
+    uint16_t len = build_packet(APID_EPS, pkt);
+    test_sub_t owner = {0}, fdir = {0}, archive = {0}, other = {0};
+
+    PBUS_Subscribe(APID_EPS, Test_Subscriber, &owner);
+    PBUS_Subscribe(APID_EPS, Test_Subscriber, &fdir);
+    PBUS_Subscribe(PBUS_APID_ANY, Test_Subscriber, &archive);
+    PBUS_Subscribe(APID_ADCS, Test_Subscriber, &other);
+
+    TEST_ASSERT_EQUAL_INT(3, PBUS_Publish(pkt, len));
+    TEST_ASSERT_EQUAL_INT(0, other.calls);
+
+    // Everyone holds the same pooled buffer
+    TEST_ASSERT_EQUAL_PTR(owner.held, fdir.held);
+    TEST_ASSERT_EQUAL_PTR(owner.held, archive.held);
+    TEST_ASSERT_EQUAL_UINT32(3, owner.held->refcount);
+    TEST_ASSERT_EQUAL_HEX16(APID_EPS, owner.held->apid);
+    TEST_ASSERT_EQUAL_MEMORY(pkt, owner.held->data, len);
+    TEST_ASSERT_EQUAL_INT(1, PBUS_BuffersInUse());
+
+    // Buffer returns to the pool only after the last release
+    PBUS_Release(owner.held);
+    PBUS_Release(fdir.held);
+    TEST_ASSERT_EQUAL_INT(1, PBUS_BuffersInUse());
+    PBUS_Release(archive.held);
+    TEST_ASSERT_EQUAL_INT(0, PBUS_BuffersInUse());
+}
+
+void test_PBUS_PoolExhaustionAndNoSubscribers(void) {
+    uint8_t pkt[32];
+    uint16_t len = build_packet(APID_PAYLOAD, pkt);
+    test_sub_t hoarder = {0};
+
+    // No subscriber: no buffer is taken
+    TEST_ASSERT_EQUAL_INT(0, PBUS_Publish(pkt, len));
+    TEST_ASSERT_EQUAL_INT(0, PBUS_BuffersInUse());
+
+    // Hold every buffer the frame pool can give
+    PBUS_Subscribe(APID_PAYLOAD, Test_Subscriber, &hoarder);
+    int held = 0;
+    while (PBUS_Publish(pkt, len) == 1) held++;
+    TEST_ASSERT_EQUAL_INT(FPOOL_SMALL_COUNT + FPOOL_FRAME_COUNT + FPOOL_LARGE_COUNT, held);
+    TEST_ASSERT_EQUAL_INT(-1, PBUS_Publish(pkt, len));
+
+    PBUS_Release(hoarder.held);
+    TEST_ASSERT_EQUAL_INT(1, PBUS_Publish(pkt, len));
+}
+
+void test_PBUS_SynchronousReleaseAndUnsubscribe(void) {
+    uint8_t pkt[32];
+    uint16_t len = build_packet(APID_HK, pkt);
+    test_sub_t quick = {0};
+    quick.release_now = 1;
+
+    int id = PBUS_Subscribe(APID_HK, Test_Subscriber, &quick);
+    PBUS_Publish(pkt, len);
+    TEST_ASSERT_EQUAL_INT(0, PBUS_BuffersInUse());
+
+    PBUS_Unsubscribe(id);
+    TEST_ASSERT_EQUAL_INT(0, PBUS_Publish(pkt, len));
+    TEST_ASSERT_EQUAL_INT(1, quick.calls);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_PBUS_FanOutSharesOneBuffer);
+    RUN_TEST(test_PBUS_PoolExhaustionAndNoSubscribers);
+    RUN_TEST(test_PBUS_SynchronousReleaseAndUnsubscribe);
+    return UNITY_END();
+}
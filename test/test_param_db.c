@@ -0,0 +1,68 @@
+#include <unity.h>
+#include <pthread.h>
+#include "param_db.h"
+
+#define WRITER_ITERATIONS 200000
+
+void setUp(void) {
+    PARAM_ResetDefaults();
+}
+
+void tearDown(void) {}
+
+void test_PARAM_DefaultsAndRangeChecks(void) {
+    TEST_ASSERT_EQUAL_INT32(20, PARAM_Get(PARAM_TARGET_TEMP));
+    TEST_ASSERT_EQUAL_INT32(500000, PARAM_Get(PARAM_ALTITUDE));
+
+    TEST_ASSERT_EQUAL_INT(0, PARAM_Set(PARAM_TARGET_TEMP, -40));
+    TEST_ASSERT_EQUAL_INT(-1, PARAM_Set(PARAM_TARGET_TEMP, 128));
+    TEST_ASSERT_EQUAL_INT(-1, PARAM_Set(PARAM_HEATER_STATUS, 2));
+    TEST_ASSERT_EQUAL_INT(-1, PARAM_Set(PARAM_COUNT, 0));
+    TEST_ASSERT_EQUAL_INT32(-40, PARAM_Get(PARAM_TARGET_TEMP));
+
+    param_snapshot_t snap;
+    PARAM_Snapshot(&snap);
+    TEST_ASSERT_EQUAL_INT32(-40, snap.v[PARAM_TARGET_TEMP]);
+    TEST_ASSERT_EQUAL_UINT32(4, snap.version);   // Four write sections so far
+}
+
+// Writer keeps ALTITUDE == 500000 + 100 * THRUSTER_DURATION inside each
+// write section; a torn snapshot would break the relation.
+static void *burn_writer(void *arg) {
+    (void)arg;
+    for (int i = 0; i < WRITER_ITERATIONS; i++) {
+        int32_t dur = i & 0xFF;
+        PARAM_WriteBegin();
+        PARAM_Store(PARAM_THRUSTER_DURATION, dur);
+        PARAM_Store(PARAM_ALTITUDE, 500000 + 100 * dur);
+        PARAM_WriteEnd();
+    }
+    return NULL;
+}
+
+void test_PARAM_SnapshotNeverTorn(void) {
+    pthread_t writer;
+    param_snapshot_t snap;
+    uint32_t torn = 0;
+    uint32_t last_version = 0;
+
+    pthread_create(&writer, NULL, burn_writer, NULL);
+    for (int i = 0; i < WRITER_ITERATIONS; i++) {
+        PARAM_Snapshot(&snap);
+        if (snap.v[PARAM_ALTITUDE] != 500000 + 100 * snap.v[PARAM_THRUSTER_DURATION]) torn++;
+        TEST_ASSERT_TRUE(snap.version >= last_version);
+        last_version = snap.version;
+    }
+    pthread_join(writer, NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    PARAM_Snapshot(&snap);
+    TEST_ASSERT_EQUAL_UINT32(WRITER_ITERATIONS, snap.version);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_PARAM_DefaultsAndRangeChecks);
+    RUN_TEST(test_PARAM_SnapshotNeverTorn);
+    return UNITY_END();
+}
@@ -0,0 +1,190 @@
+#include <unity.h>
+#include <string.h>
+#include "comms_frame.h"
+#include "ccsds_packet.h"
+#include "frame_pool.h"
+#include "reassembly.h"
+#include "tm_downlink.h"
+#include "time_service.h"
+
+// Unsegmented packets fall through to the router
+static int routed = 0;
+void CDHS_RoutePacket(const uint8_t* packet, uint16_t len) {
+    (void)packet;
+    (void)len;
+    routed++;
+}
+
+static uint8_t delivered[REASM_MAX_SIZE];
+static uint32_t delivered_len = 0;
+static uint16_t delivered_apid = 0;
+static int deliveries = 0;
+
+static void Test_Sink(uint16_t apid, const uint8_t *data, uint32_t len, void *ctx) {
+    (void)ctx;
+    memcpy(delivered, data, len);
+    delivered_len = len;
+    delivered_apid = apid;
+    deliveries++;
+}
+
+// The test radio loops every frame straight back into the parser,
+// optionally losing one of them
+static int frames_sent = 0;
+static int drop_frame = -1;
+
+static void Loopback_Radio(uint8_t *frame, uint16_t frame_len) {
+    if (frames_sent++ != drop_frame) {
+        for (int i = 0; i < frame_len; i++) COMMS_ParseByte(frame[i]);
+    }
+    TM_ReleaseFrame(frame);
+}
+
+void setUp(void) {
+    TIME_Init();
+    COMMS_ResetParser();
+    COMMS_ResetReplayWindows();
+    REASM_Init();
+    FPOOL_Reset();
+    REASM_SetSink(Test_Sink, NULL);
+    COMMS_SetRouteHandler(REASM_RouteHandler);
+    TM_SetDownlinkSink(Loopback_Radio);
+    routed = deliveries = frames_sent = 0;
+    drop_frame = -1;
+}
+
+void tearDown(void) {
+    COMMS_SetRouteHandler(NULL);
+    TM_SetDownlinkSink(NULL);
+}
+
+static void fill_pattern(uint8_t *buf, uint32_t len, uint8_t seed) {
+    for (uint32_t i = 0; i < len; i++) buf[i] = (uint8_t)(i * 7u + seed);
+}
+
+static CCSDS_TcView_t segment(uint16_t apid, uint8_t flags, uint16_t seq, const uint8_t *data, uint16_t len) {
+    CCSDS_TcView_t v = { .apid = apid, .seq_flags = flags, .seq_count = seq, .app_data = data, .app_data_len = len };
+    return v;
+}
+
+void test_REASM_SegmentedRoundTripThroughParser(void) {
+    static uint8_t image[1000];
+    fill_pattern(image, sizeof(image), 3);
+
+    // 1000 bytes = 20 segments of TM_MAX_APP_DATA
+    TEST_ASSERT_EQUAL_INT(20, TM_SendSegmented(APID_PAYLOAD, image, sizeof(image)));
+
+    TEST_ASSERT_EQUAL_INT(1, deliveries);
+    TEST_ASSERT_EQUAL_HEX16(APID_PAYLOAD, delivered_apid);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(image), delivered_len);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(image, delivered, sizeof(image));
+    TEST_ASSERT_EQUAL_INT(0, REASM_ActiveSlots());
+    TEST_ASSERT_EQUAL_INT(0, routed);
+
+    // Short data still goes out as one unsegmented packet and is routed as before
+    TEST_ASSERT_EQUAL_INT(1, TM_SendSegmented(APID_PAYLOAD, image, TM_MAX_APP_DATA));
+    TEST_ASSERT_EQUAL_INT(1, routed);
+    TEST_ASSERT_EQUAL_INT(1, deliveries);
+
+    fpool_stats_t pool;
+    FPOOL_GetStats(FPOOL_CLASS_FRAME, &pool);
+    TEST_ASSERT_EQUAL_UINT32(0, pool.in_use);
+}
+
+void test_REASM_LostSegmentDiscardsPacket(void) {
+    static uint8_t patch[400];
+    reasm_stats_t stats;
+    fill_pattern(patch, sizeof(patch), 9);
+
+    drop_frame = 3;
+    TEST_ASSERT_EQUAL_INT(8, TM_SendSegmented(APID_CDHS, patch, sizeof(patch)));
+
+    // The segment after the hole closes the slot; the rest are orphans
+    REASM_GetStats(&stats);
+    TEST_ASSERT_EQUAL_INT(0, deliveries);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.gaps);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.orphans);
+    TEST_ASSERT_EQUAL_INT(0, REASM_ActiveSlots());
+
+    // The next transfer on the same APID goes through cleanly
+    drop_frame = -1;
+    TM_SendSegmented(APID_CDHS, patch, sizeof(patch));
+    TEST_ASSERT_EQUAL_INT(1, deliveries);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(patch, delivered, sizeof(patch));
+}
+
+void test_REASM_InterleavedApidsUseSeparateSlots(void) {
+    uint8_t a[3][10], b[2][10];
+    reasm_result_t last_a, last_b;
+    for (int i = 0; i < 3; i++) fill_pattern(a[i], 10, (uint8_t)(i * 10));
+    for (int i = 0; i < 2; i++) fill_pattern(b[i], 10, (uint8_t)(100 + i * 10));
+
+    CCSDS_TcView_t va0 = segment(APID_ADCS, CCSDS_SEQ_FIRST, 100, a[0], 10);
+    CCSDS_TcView_t vb0 = segment(APID_EPS, CCSDS_SEQ_FIRST, 0x3FFF, b[0], 10);
+    CCSDS_TcView_t va1 = segment(APID_ADCS, CCSDS_SEQ_CONTINUATION, 101, a[1], 10);
+    CCSDS_TcView_t vb1 = segment(APID_EPS, CCSDS_SEQ_LAST, 0, b[1], 10);   // Count wraps
+    CCSDS_TcView_t va2 = segment(APID_ADCS, CCSDS_SEQ_LAST, 102, a[2], 10);
+
+    TEST_ASSERT_EQUAL_INT(REASM_PENDING, REASM_Submit(&va0));
+    TEST_ASSERT_EQUAL_INT(REASM_PENDING, REASM_Submit(&vb0));
+    TEST_ASSERT_EQUAL_INT(REASM_PENDING, REASM_Submit(&va1));
+    TEST_ASSERT_EQUAL_INT(2, REASM_ActiveSlots());
+
+    last_b = REASM_Submit(&vb1);
+    TEST_ASSERT_EQUAL_INT(REASM_COMPLETE, last_b);
+    TEST_ASSERT_EQUAL_HEX16(APID_EPS, delivered_apid);
+    TEST_ASSERT_EQUAL_UINT32(20, delivered_len);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(b[1], &delivered[10], 10);
+
+    last_a = REASM_Submit(&va2);
+    TEST_ASSERT_EQUAL_INT(REASM_COMPLETE, last_a);
+    TEST_ASSERT_EQUAL_UINT32(30, delivered_len);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(a[0], delivered, 10);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(a[2], &delivered[20], 10);
+}
+
+void test_REASM_SlotLimitsTimeoutAndOverflow(void) {
+    static uint8_t big[TM_MAX_APP_DATA];
+    reasm_stats_t stats;
+
+    // 1. One more APID than there are slots
+    for (uint16_t i = 0; i <= REASM_SLOTS; i++) {
+        CCSDS_TcView_t v = segment((uint16_t)(0x100 + i), CCSDS_SEQ_FIRST, 0, big, 8);
+        REASM_Submit(&v);
+    }
+    REASM_GetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.no_slot);
+    TEST_ASSERT_EQUAL_INT(REASM_SLOTS, REASM_ActiveSlots());
+
+    // 2. Idle slots expire after the timeout
+    REASM_SetTimeout(100);
+    for (int i = 0; i < 100; i++) TIME_Tick1ms();
+    TEST_ASSERT_EQUAL_INT(0, REASM_Tick());
+    TIME_Tick1ms();
+    TEST_ASSERT_EQUAL_INT(REASM_SLOTS, REASM_Tick());
+    REASM_GetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(REASM_SLOTS, stats.timeouts);
+
+    // 3. A packet that outgrows the buffer is dropped, not truncated
+    CCSDS_TcView_t v = segment(APID_PAYLOAD, CCSDS_SEQ_FIRST, 0, big, sizeof(big));
+    REASM_Submit(&v);
+    uint16_t seq = 1;
+    for (uint32_t len = sizeof(big); len + sizeof(big) <= REASM_MAX_SIZE; len += sizeof(big)) {
+        v = segment(APID_PAYLOAD, CCSDS_SEQ_CONTINUATION, seq++, big, sizeof(big));
+        TEST_ASSERT_EQUAL_INT(REASM_PENDING, REASM_Submit(&v));
+    }
+    v = segment(APID_PAYLOAD, CCSDS_SEQ_LAST, seq, big, sizeof(big));
+    TEST_ASSERT_EQUAL_INT(REASM_DROPPED, REASM_Submit(&v));
+    REASM_GetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.overflows);
+    TEST_ASSERT_EQUAL_INT(0, deliveries);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_REASM_SegmentedRoundTripThroughParser);
+    RUN_TEST(test_REASM_LostSegmentDiscardsPacket);
+    RUN_TEST(test_REASM_InterleavedApidsUseSeparateSlots);
+    RUN_TEST(test_REASM_SlotLimitsTimeoutAndOverflow);
+    return UNITY_END();
+}
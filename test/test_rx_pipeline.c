@@ -0,0 +1,190 @@
+#include <unity.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "comms_frame.h"
+#include "ccsds_packet.h"
+#include "rx_pipeline.h"
+#include "frame_pool.h"
+
+// Stage 2 handler: records sequence counts and can be held shut
+static uint16_t dispatched_seq[64];
+static int dispatched_count;
+static int handler_entered;
+static pthread_t dispatch_thread;
+static int gate_open;   // Shared with the dispatch thread, atomic accesses only
+
+static void record_dispatch(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view) {
+    (void)packet;
+    (void)len;
+    __atomic_add_fetch(&handler_entered, 1, __ATOMIC_RELEASE);
+    while (!__atomic_load_n(&gate_open, __ATOMIC_ACQUIRE)) usleep(100);
+    dispatch_thread = pthread_self();
+    if (dispatched_count < 64) dispatched_seq[dispatched_count] = view->seq_count;
+    __atomic_add_fetch(&dispatched_count, 1, __ATOMIC_RELEASE);
+}
+
+static const rxp_config_t test_config = {
+    .ingest_core = RXP_CORE_ANY,
+    .dispatch_core = RXP_CORE_ANY,
+    .dispatch = record_dispatch,
+};
+
+void setUp(void) {
+    COMMS_ResetReplayWindows();
+    FPOOL_Reset();
+    dispatched_count = 0;
+    handler_entered = 0;
+    __atomic_store_n(&gate_open, 1, __ATOMIC_RELEASE);
+}
+
+void tearDown(void) {
+    __atomic_store_n(&gate_open, 1, __ATOMIC_RELEASE);
+    RXP_Stop();
+}
+
+// Appends one framed CDHS telecommand to out, returns bytes written
+static size_t frame_tc(uint8_t *out, uint16_t seq) {
+    uint8_t pkt[CCSDS_HEADERS_SIZE + 4];
+    uint8_t args[4] = {0x42, 1, 2, 3};
+    comms_frame_t frame;
+
+    CCSDS_BuildHeaders(pkt, APID_CDHS, (uint16_t)(0xC000 | seq), sizeof(args), 0);
+    memcpy(&pkt[CCSDS_HEADERS_SIZE], args, sizeof(args));
+    COMMS_CreateFrame(&frame, pkt, sizeof(pkt));
+    return COMMS_SerializeFrame(&frame, out);
+}
+
+static void wait_parsed(uint32_t frames) {
+    rxp_stats_t stats;
+    for (int wait = 0; wait < 1000; wait++) {
+        RXP_GetStats(&stats);
+        if (stats.frames_queued + stats.frames_dropped >= frames) return;
+        usleep(1000);
+    }
+}
+
+void test_RXP_DispatchesInOrderOnSecondStage(void) {
+    uint8_t stream[1024];
+    size_t len = 0;
+
+    TEST_ASSERT_EQUAL_INT(0, RXP_Start(&test_config));
+
+    // Ten frames with line noise in between, delivered in uneven chunks
+    for (uint16_t seq = 0; seq < 10; seq++) {
+        len += frame_tc(&stream[len], seq);
+        stream[len++] = 0x55;
+    }
+    TEST_ASSERT_EQUAL_size_t(7, RXP_Receive(stream, 7));
+    TEST_ASSERT_EQUAL_size_t(len - 7, RXP_Receive(&stream[7], len - 7));
+    TEST_ASSERT_TRUE(RXP_WaitIdle(1000));
+
+    TEST_ASSERT_EQUAL_INT(10, dispatched_count);
+    for (int i = 0; i < 10; i++) TEST_ASSERT_EQUAL_UINT16(i, dispatched_seq[i]);
+    TEST_ASSERT_FALSE(pthread_equal(dispatch_thread, pthread_self()));
+
+    // Every descriptor handed its pool block back
+    fpool_stats_t pool;
+    FPOOL_GetStats(FPOOL_CLASS_FRAME, &pool);
+    TEST_ASSERT_EQUAL_UINT32(0, pool.in_use);
+    FPOOL_GetStats(FPOOL_CLASS_SMALL, &pool);
+    TEST_ASSERT_EQUAL_UINT32(0, pool.in_use);
+}
+
+void test_RXP_SlowHandlerDoesNotStallParsing(void) {
+    uint8_t stream[2048];
+    size_t len = 0;
+    rxp_stats_t stats;
+
+    __atomic_store_n(&gate_open, 0, __ATOMIC_RELEASE);
+    TEST_ASSERT_EQUAL_INT(0, RXP_Start(&test_config));
+    for (uint16_t seq = 0; seq < 40; seq++) len += frame_tc(&stream[len], seq);
+    TEST_ASSERT_EQUAL_size_t(len, RXP_Receive(stream, len));
+
+    // 1. Stage 1 gets through every frame while stage 2 is stuck in its handler
+    wait_parsed(40);
+    RXP_GetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(len, stats.bytes_in);
+    TEST_ASSERT_EQUAL_UINT32(RXP_FRAME_DEPTH, stats.frames_queued);
+    TEST_ASSERT_EQUAL_UINT32(40 - RXP_FRAME_DEPTH, stats.frames_dropped);
+    TEST_ASSERT_EQUAL_UINT32(RXP_FRAME_DEPTH, stats.frame_high_water);
+
+    // 2. Once the handler frees up, the queued frames drain in order
+    __atomic_store_n(&gate_open, 1, __ATOMIC_RELEASE);
+    TEST_ASSERT_TRUE(RXP_WaitIdle(1000));
+    RXP_GetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(RXP_FRAME_DEPTH, stats.frames_dispatched);
+    TEST_ASSERT_EQUAL_UINT16(RXP_FRAME_DEPTH - 1, dispatched_seq[RXP_FRAME_DEPTH - 1]);
+
+    // 3. Dropped commands were never delivered: their retransmissions get through
+    len = 0;
+    for (uint16_t seq = RXP_FRAME_DEPTH; seq < 2 * RXP_FRAME_DEPTH; seq++) len += frame_tc(&stream[len], seq);
+    TEST_ASSERT_EQUAL_size_t(len, RXP_Receive(stream, len));
+    TEST_ASSERT_TRUE(RXP_WaitIdle(1000));
+    RXP_GetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(2 * RXP_FRAME_DEPTH, stats.frames_dispatched);
+    TEST_ASSERT_EQUAL_UINT16(2 * RXP_FRAME_DEPTH - 1, dispatched_seq[2 * RXP_FRAME_DEPTH - 1]);
+}
+
+static void *stop_pipeline(void *arg) {
+    (void)arg;
+    RXP_Stop();
+    return NULL;
+}
+
+void test_RXP_StopReleasesUndispatchedCommands(void) {
+    uint8_t stream[256];
+    size_t len = 0;
+    pthread_t stopper;
+    comms_replay_stats_t replay;
+
+    __atomic_store_n(&gate_open, 0, __ATOMIC_RELEASE);
+    TEST_ASSERT_EQUAL_INT(0, RXP_Start(&test_config));
+    for (uint16_t seq = 0; seq < 4; seq++) len += frame_tc(&stream[len], seq);
+    TEST_ASSERT_EQUAL_size_t(len, RXP_Receive(stream, len));
+    wait_parsed(4);
+    for (int wait = 0; wait < 1000 && __atomic_load_n(&handler_entered, __ATOMIC_ACQUIRE) == 0; wait++) usleep(1000);
+
+    // 1. Stop while seq 0 is in its handler and 1..3 are still queued
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&stopper, NULL, stop_pipeline, NULL));
+    usleep(50000);
+    __atomic_store_n(&gate_open, 1, __ATOMIC_RELEASE);
+    pthread_join(stopper, NULL);
+    TEST_ASSERT_EQUAL_INT(1, dispatched_count);
+    COMMS_GetReplayStats(&replay);
+    TEST_ASSERT_EQUAL_UINT32(3, replay.released);
+
+    // 2. After a restart the ground's retransmissions are not duplicates
+    len = 0;
+    for (uint16_t seq = 1; seq < 4; seq++) len += frame_tc(&stream[len], seq);
+    TEST_ASSERT_EQUAL_INT(0, RXP_Start(&test_config));
+    TEST_ASSERT_EQUAL_size_t(len, RXP_Receive(stream, len));
+    TEST_ASSERT_TRUE(RXP_WaitIdle(1000));
+    TEST_ASSERT_EQUAL_INT(4, dispatched_count);
+    for (int i = 0; i < 4; i++) TEST_ASSERT_EQUAL_UINT16(i, dispatched_seq[i]);
+}
+
+void test_RXP_ByteRingOverflowIsCounted(void) {
+    static uint8_t noise[RXP_BYTE_RING + 100];
+    rxp_stats_t stats;
+
+    // Stopped pipeline: nothing drains the ring
+    TEST_ASSERT_EQUAL_INT(0, RXP_Start(&test_config));
+    RXP_Stop();
+    memset(noise, 0x55, sizeof(noise));
+    TEST_ASSERT_EQUAL_size_t(RXP_BYTE_RING, RXP_Receive(noise, sizeof(noise)));
+    TEST_ASSERT_EQUAL_size_t(0, RXP_Receive(noise, 1));
+
+    RXP_GetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(RXP_BYTE_RING, stats.bytes_in);
+    TEST_ASSERT_EQUAL_UINT32(101, stats.bytes_dropped);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_RXP_DispatchesInOrderOnSecondStage);
+    RUN_TEST(test_RXP_SlowHandlerDoesNotStallParsing);
+    RUN_TEST(test_RXP_StopReleasesUndispatchedCommands);
+    RUN_TEST(test_RXP_ByteRingOverflowIsCounted);
+    return UNITY_END();
+}
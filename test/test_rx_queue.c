@@ -0,0 +1,164 @@
+#include <unity.h>
+#include <string.h>
+#include <unistd.h>
+#include "comms_frame.h"
+#include "ccsds_packet.h"
+#include "rx_queue.h"
+#include "frame_pool.h"
+#include "time_service.h"
+
+// This test owns the router so it can record delivery order
+static uint16_t routed_apids[32];
+static int routed_count = 0;
+
+void CDHS_RoutePacket(const uint8_t* packet, uint16_t len) {
+    (void)len;
+    if (routed_count < 32) {
+        routed_apids[routed_count] = CCSDS_GetAPID(packet);
+    }
+    __atomic_add_fetch(&routed_count, 1, __ATOMIC_RELEASE);
+}
+
+void setUp(void) {
+    TIME_Init();
+    COMMS_ResetReplayWindows();
+    // RXQ_Init frees the blocks a previous test left queued, so it must run
+    // before FPOOL_Reset: freeing them after the reset would push blocks
+    // that are already free onto the list twice
+    RXQ_Init();
+    FPOOL_Reset();
+    routed_count = 0;
+}
+
+void tearDown(void) {
+    RXQ_StopWorker();
+    COMMS_SetRouteHandler(NULL);
+}
+
+static void enqueue_packet(uint16_t apid) {
+    uint8_t pkt[32];
+    uint8_t data[] = {0x01, 0x02};
+    CCSDS_TcView_t view;
+
+    CCSDS_WrapTelemetry(apid, data, sizeof(data), pkt);
+    CCSDS_ValidateTelecommand(pkt, CCSDS_HEADERS_SIZE + sizeof(data), &view);
+    RXQ_Enqueue(pkt, CCSDS_HEADERS_SIZE + sizeof(data), &view);
+}
+
+void test_RXQ_StrictPriorityOrder(void) {
+    enqueue_packet(APID_PAYLOAD);
+    enqueue_packet(APID_EPS);
+    enqueue_packet(APID_PAYLOAD);
+    enqueue_packet(APID_ADCS);
+    enqueue_packet(APID_FDIR);
+
+    TEST_ASSERT_EQUAL_INT(5, RXQ_ProcessPending());
+    TEST_ASSERT_EQUAL_HEX16(APID_FDIR, routed_apids[0]);
+    TEST_ASSERT_EQUAL_HEX16(APID_ADCS, routed_apids[1]);
+    TEST_ASSERT_EQUAL_HEX16(APID_EPS, routed_apids[2]);
+    TEST_ASSERT_EQUAL_HEX16(APID_PAYLOAD, routed_apids[3]);
+    TEST_ASSERT_EQUAL_HEX16(APID_PAYLOAD, routed_apids[4]);
+
+    // Every routed packet handed its pool block back
+    fpool_stats_t pool;
+    FPOOL_GetStats(FPOOL_CLASS_SMALL, &pool);
+    TEST_ASSERT_EQUAL_UINT32(0, pool.in_use);
+    TEST_ASSERT_EQUAL_UINT32(5, pool.high_water);
+}
+
+void test_RXQ_FullQueueDropsOnlyThatPriority(void) {
+    rxq_stats_t stats;
+
+    for (int i = 0; i < RXQ_DEPTH + 3; i++) enqueue_packet(APID_PAYLOAD);
+    enqueue_packet(APID_CDHS);
+
+    RXQ_GetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.dropped[RXQ_PRIO_PAYLOAD]);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.dropped[RXQ_PRIO_SAFETY]);
+    TEST_ASSERT_EQUAL_UINT8(RXQ_DEPTH, stats.high_water[RXQ_PRIO_PAYLOAD]);
+
+    // The critical command still goes first
+    TEST_ASSERT_EQUAL_INT(RXQ_DEPTH + 1, RXQ_ProcessPending());
+    TEST_ASSERT_EQUAL_HEX16(APID_CDHS, routed_apids[0]);
+}
+
+void test_RXQ_PriorityIsConfigurablePerAPID(void) {
+    RXQ_SetPriority(APID_PAYLOAD, RXQ_PRIO_SAFETY);
+    TEST_ASSERT_EQUAL_INT(RXQ_PRIO_SAFETY, RXQ_GetPriority(APID_PAYLOAD));
+
+    enqueue_packet(APID_ADCS);
+    enqueue_packet(APID_PAYLOAD);
+    RXQ_ProcessPending();
+    TEST_ASSERT_EQUAL_HEX16(APID_PAYLOAD, routed_apids[0]);
+}
+
+void test_RXQ_WorkerDrainsParserOutput(void) {
+    uint8_t pkt[32];
+    uint8_t data[] = {0xB2, 15};
+    comms_frame_t frame;
+    uint8_t wire[MAX_FRAME_SIZE];
+    uint16_t pkt_len = CCSDS_HEADERS_SIZE + sizeof(data);
+
+    TEST_ASSERT_EQUAL_INT(0, RXQ_StartWorker());
+
+    // Feed a full frame through the parser; routing happens on the worker
+    CCSDS_WrapTelemetry(APID_ADCS, data, sizeof(data), pkt);
+    COMMS_ResetParser();
+    COMMS_CreateFrame(&frame, pkt, (uint8_t)pkt_len);
+    uint16_t wire_len = COMMS_SerializeFrame(&frame, wire);
+    for (int i = 0; i < wire_len - 1; i++) COMMS_ParseByte(wire[i]);
+    TEST_ASSERT_EQUAL_INT(1, COMMS_ParseByte(wire[wire_len - 1]));
+
+    for (int wait = 0; wait < 1000 && __atomic_load_n(&routed_count, __ATOMIC_ACQUIRE) == 0; wait++) usleep(1000);
+    RXQ_StopWorker();   // Joins the worker before we read its results
+    TEST_ASSERT_EQUAL_INT(1, routed_count);
+    TEST_ASSERT_EQUAL_HEX16(APID_ADCS, routed_apids[0]);
+}
+
+// Feeds one framed telecommand through the parser (and so the replay window)
+static void parse_tc(uint16_t apid, uint16_t seq) {
+    uint8_t pkt[CCSDS_HEADERS_SIZE + 2];
+    uint8_t data[] = {0x01, 0x02};
+    comms_frame_t frame;
+    uint8_t wire[MAX_FRAME_SIZE];
+
+    CCSDS_BuildHeaders(pkt, apid, (uint16_t)(0xC000 | seq), sizeof(data), 0);
+    memcpy(&pkt[CCSDS_HEADERS_SIZE], data, sizeof(data));
+    COMMS_CreateFrame(&frame, pkt, sizeof(pkt));
+    uint16_t wire_len = COMMS_SerializeFrame(&frame, wire);
+    for (int i = 0; i < wire_len; i++) COMMS_ParseByte(wire[i]);
+}
+
+void test_RXQ_DroppedCommandCanBeRetransmitted(void) {
+    rxq_stats_t stats;
+    comms_replay_stats_t replay;
+
+    // 1. One more than the queue holds: the last count is dropped
+    COMMS_ResetParser();
+    for (uint16_t seq = 0; seq <= RXQ_DEPTH; seq++) parse_tc(APID_PAYLOAD, seq);
+    RXQ_GetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.dropped[RXQ_PRIO_PAYLOAD]);
+    COMMS_GetReplayStats(&replay);
+    TEST_ASSERT_EQUAL_UINT32(1, replay.released);
+    TEST_ASSERT_EQUAL_INT(RXQ_DEPTH, RXQ_ProcessPending());
+
+    // 2. The ground resends the same count: not a duplicate, it gets through
+    parse_tc(APID_PAYLOAD, RXQ_DEPTH);
+    TEST_ASSERT_EQUAL_INT(1, RXQ_ProcessPending());
+
+    // 3. Once delivered, a further repeat is a real duplicate
+    parse_tc(APID_PAYLOAD, RXQ_DEPTH);
+    TEST_ASSERT_EQUAL_INT(0, RXQ_ProcessPending());
+    COMMS_GetReplayStats(&replay);
+    TEST_ASSERT_EQUAL_UINT32(1, replay.duplicates);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_RXQ_StrictPriorityOrder);
+    RUN_TEST(test_RXQ_FullQueueDropsOnlyThatPriority);
+    RUN_TEST(test_RXQ_PriorityIsConfigurablePerAPID);
+    RUN_TEST(test_RXQ_WorkerDrainsParserOutput);
+    RUN_TEST(test_RXQ_DroppedCommandCanBeRetransmitted);
+    return UNITY_END();
+}
@@ -0,0 +1,151 @@
+#include <unity.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "ccsds_packet.h"
+#include "byte_order.h"
+#include "tm_archive.h"
+#include "time_service.h"
+
+static char archive_path[] = "/tmp/tm_archive_testXXXXXX";
+
+// Collects what a dump would hand to the framer
+static uint16_t dumped_apids[512];
+static uint64_t dumped_met[512];
+static int dumped = 0;
+
+static void Test_Framer(const uint8_t *packet, uint16_t len) {
+    (void)len;
+    dumped_apids[dumped] = CCSDS_GetAPID(packet);
+    dumped_met[dumped] = BE_Load64(packet + CCSDS_MET_OFFSET);
+    dumped++;
+}
+
+static void store_at(uint64_t met, uint16_t apid, uint16_t data_len) {
+    uint8_t data[256] = {0};
+    uint8_t pkt[CCSDS_HEADERS_SIZE + 256];
+    while (TIME_GetMilliseconds() < met) TIME_Tick1ms();
+    CCSDS_WrapTelemetry(apid, data, data_len, pkt);
+    TEST_ASSERT_EQUAL_INT(0, ARCH_Store(pkt, CCSDS_HEADERS_SIZE + data_len));
+}
+
+void setUp(void) {
+    int fd = mkstemp(archive_path);
+    close(fd);
+    TIME_Init();
+    dumped = 0;
+}
+
+void tearDown(void) {
+    ARCH_Close();
+    unlink(archive_path);
+    strcpy(archive_path, "/tmp/tm_archive_testXXXXXX");
+}
+
+void test_ARCH_QueryByApidAndTimeRange(void) {
+    arch_cursor_t cursor;
+    TEST_ASSERT_EQUAL_INT(0, ARCH_OpenFile(archive_path, 16 * ARCH_SECTOR_SIZE));
+
+    for (int t = 1; t <= 100; t++) {
+        store_at((uint64_t)t * 10, (t % 2) ? APID_EPS : APID_ARCHIVE, 40);
+    }
+    TEST_ASSERT_EQUAL_UINT32(100, ARCH_RecordCount());
+
+    // EPS between 200 and 400 ms: t = 21, 23, ..., 39
+    ARCH_DumpBegin(&cursor, APID_EPS, 200, 400);
+    while (ARCH_DumpNext(&cursor, Test_Framer, 4) > 0) {
+    }
+    TEST_ASSERT_TRUE(cursor.done);
+    TEST_ASSERT_EQUAL_INT(10, dumped);
+    TEST_ASSERT_EQUAL_UINT64(210, dumped_met[0]);
+    TEST_ASSERT_EQUAL_UINT64(390, dumped_met[9]);
+    for (int i = 0; i < dumped; i++) TEST_ASSERT_EQUAL_HEX16(APID_EPS, dumped_apids[i]);
+}
+
+void test_ARCH_WrapDropsOldestSectorOnly(void) {
+    arch_cursor_t cursor;
+    TEST_ASSERT_EQUAL_INT(0, ARCH_OpenFile(archive_path, 4 * ARCH_SECTOR_SIZE));
+
+    // ~4 KB of 216-byte records per sector: 300 records wrap the 4-sector ring
+    for (int t = 1; t <= 300; t++) store_at((uint64_t)t, APID_PAYLOAD, 200);
+
+    uint32_t kept = ARCH_RecordCount();
+    TEST_ASSERT_TRUE(kept < 300);
+    TEST_ASSERT_TRUE(kept > 2 * (ARCH_SECTOR_SIZE / 216));
+
+    // Everything still there comes out oldest first and ends at the newest
+    ARCH_DumpBegin(&cursor, ARCH_APID_ANY, 0, UINT64_MAX);
+    while (ARCH_DumpNext(&cursor, Test_Framer, 64) > 0) {
+    }
+    TEST_ASSERT_EQUAL_INT((int)kept, dumped);
+    for (int i = 1; i < dumped; i++) TEST_ASSERT_TRUE(dumped_met[i] == dumped_met[i - 1] + 1);
+    TEST_ASSERT_EQUAL_UINT64(300, dumped_met[dumped - 1]);
+}
+
+void test_ARCH_ReopenRebuildsIndex(void) {
+    arch_cursor_t cursor;
+    TEST_ASSERT_EQUAL_INT(0, ARCH_OpenFile(archive_path, 8 * ARCH_SECTOR_SIZE));
+    for (int t = 1; t <= 50; t++) store_at((uint64_t)t, APID_HK, 100);
+    ARCH_Close();
+
+    // After a reboot the log is re-indexed and appends continue after the last record
+    TEST_ASSERT_EQUAL_INT(0, ARCH_OpenFile(archive_path, 8 * ARCH_SECTOR_SIZE));
+    TEST_ASSERT_EQUAL_UINT32(50, ARCH_RecordCount());
+    store_at(60, APID_HK, 100);
+
+    ARCH_DumpBegin(&cursor, APID_HK, 45, 100);
+    while (ARCH_DumpNext(&cursor, Test_Framer, 8) > 0) {
+    }
+    TEST_ASSERT_EQUAL_INT(7, dumped);
+    TEST_ASSERT_EQUAL_UINT64(60, dumped_met[6]);
+}
+
+void test_ARCH_TornWriteIsNotOverwrittenAfterRemount(void) {
+    static uint8_t image[8 * ARCH_SECTOR_SIZE];
+    uint8_t torn[CCSDS_HEADERS_SIZE + 40] = {0};
+    arch_cursor_t cursor;
+
+    TEST_ASSERT_EQUAL_INT(0, ARCH_OpenFile(archive_path, 8 * ARCH_SECTOR_SIZE));
+    for (int t = 1; t <= 10; t++) store_at((uint64_t)t, APID_HK, 40);
+    ARCH_Close();
+
+    // 1. Power lost mid-append: the packet landed, its 16-byte header did not
+    FILE *f = fopen(archive_path, "r+b");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL_size_t(sizeof(image), fread(image, 1, sizeof(image), f));
+    size_t end = ARCH_SECTOR_SIZE;
+    while (end > 0 && image[end - 1] == 0xFF) end--;
+    end = (end + 3u) & ~(size_t)3u;
+    CCSDS_WrapTelemetry(APID_PAYLOAD, &torn[CCSDS_HEADERS_SIZE], 40, torn);
+    BE_Store64(&torn[CCSDS_MET_OFFSET], 999);
+    fseek(f, (long)(end + 16), SEEK_SET);
+    fwrite(torn, 1, sizeof(torn), f);
+    fclose(f);
+
+    // 2. Reboot: the half record is ignored and new appends avoid its bytes
+    TEST_ASSERT_EQUAL_INT(0, ARCH_OpenFile(archive_path, 8 * ARCH_SECTOR_SIZE));
+    TEST_ASSERT_EQUAL_UINT32(10, ARCH_RecordCount());
+    for (int t = 11; t <= 15; t++) store_at((uint64_t)t, APID_HK, 40);
+    ARCH_Close();
+
+    // 3. After another reboot every record reads back intact and in order
+    TEST_ASSERT_EQUAL_INT(0, ARCH_OpenFile(archive_path, 8 * ARCH_SECTOR_SIZE));
+    ARCH_DumpBegin(&cursor, ARCH_APID_ANY, 0, UINT64_MAX);
+    while (ARCH_DumpNext(&cursor, Test_Framer, 8) > 0) {
+    }
+    TEST_ASSERT_EQUAL_INT(15, dumped);
+    for (int i = 0; i < dumped; i++) {
+        TEST_ASSERT_EQUAL_HEX16(APID_HK, dumped_apids[i]);
+        TEST_ASSERT_EQUAL_UINT64((uint64_t)i + 1, dumped_met[i]);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_ARCH_QueryByApidAndTimeRange);
+    RUN_TEST(test_ARCH_WrapDropsOldestSectorOnly);
+    RUN_TEST(test_ARCH_ReopenRebuildsIndex);
+    RUN_TEST(test_ARCH_TornWriteIsNotOverwrittenAfterRemount);
+    return UNITY_END();
+}
@@ -0,0 +1,139 @@
+#include <unity.h>
+#include <string.h>
+#include "comms_frame.h"
+#include "ccsds_packet.h"
+#include "byte_order.h"
+#include "frame_pool.h"
+#include "tm_downlink.h"
+#include "time_service.h"
+
+// The test radio keeps the last committed frame
+static uint8_t *sent_frame = NULL;
+static uint16_t sent_len = 0;
+
+static void Test_Radio(uint8_t *frame, uint16_t frame_len) {
+    sent_frame = frame;
+    sent_len = frame_len;
+}
+
+static int routed = 0;
+static CCSDS_TcView_t routed_view;
+static void Count_Route(const uint8_t *packet, uint16_t len, const CCSDS_TcView_t *view) {
+    (void)packet; (void)len;
+    routed_view = *view;
+    routed++;
+}
+
+void setUp(void) {
+    TIME_Init();
+    FPOOL_Reset();
+    TM_SetDownlinkSink(Test_Radio);
+    sent_frame = NULL;
+    routed = 0;
+}
+
+void tearDown(void) {
+    COMMS_SetRouteHandler(NULL);
+}
+
+void test_TM_ReserveCommitBuildsWireFrameInPlace(void) {
+    for (int i = 0; i < 250; i++) TIME_Tick1ms();
+
+    // ADCS writes its fields straight into the downlink buffer
+    uint8_t *p = TM_Reserve(APID_ADCS, 6);
+    TEST_ASSERT_NOT_NULL(p);
+    BE_Store16(&p[0], 0x1234);
+    BE_Store32(&p[2], 0xCAFEF00D);
+    TEST_ASSERT_EQUAL_INT(0, TM_Commit(p));
+
+    TEST_ASSERT_NOT_NULL(sent_frame);
+    TEST_ASSERT_EQUAL_PTR(p - 2 - CCSDS_HEADERS_SIZE, sent_frame);   // Same buffer, no copy
+    TEST_ASSERT_EQUAL_UINT16(2 + CCSDS_HEADERS_SIZE + 6 + 2, sent_len);
+    TEST_ASSERT_EQUAL_HEX8(FRAME_START_BYTE, sent_frame[0]);
+    TEST_ASSERT_EQUAL_HEX16(APID_ADCS, CCSDS_GetAPID(&sent_frame[2]));
+    TEST_ASSERT_EQUAL_UINT64(250, BE_Load64(&sent_frame[2 + CCSDS_MET_OFFSET]));
+
+    // The ground-side parser accepts it as-is
+    COMMS_ResetParser();
+    COMMS_ResetReplayWindows();
+    COMMS_SetRouteHandler(Count_Route);
+    for (int i = 0; i < sent_len; i++) COMMS_ParseByte(sent_frame[i]);
+    TEST_ASSERT_EQUAL_INT(1, routed);
+    TEST_ASSERT_EQUAL_HEX32(0xCAFEF00D, BE_Load32(&routed_view.app_data[2]));
+
+    TM_ReleaseFrame(sent_frame);
+    fpool_stats_t stats;
+    FPOOL_GetStats(FPOOL_CLASS_SMALL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.in_use);
+}
+
+void test_TM_SequenceCountPerApid(void) {
+    uint8_t *p;
+    uint16_t first, second;
+
+    p = TM_Reserve(APID_PAYLOAD, 1);
+    TM_Commit(p);
+    first = BE_Load16(&sent_frame[2 + CCSDS_SEQ_CTRL_OFFSET]);
+    TM_ReleaseFrame(sent_frame);
+
+    p = TM_Reserve(APID_PAYLOAD, 1);
+    TM_Commit(p);
+    second = BE_Load16(&sent_frame[2 + CCSDS_SEQ_CTRL_OFFSET]);
+    TM_ReleaseFrame(sent_frame);
+
+    TEST_ASSERT_EQUAL_HEX16(0xC000, first & 0xC000);
+    TEST_ASSERT_EQUAL_UINT16((first + 1) & 0x3FFF, second & 0x3FFF);
+}
+
+void test_TM_ReserveLimitsAndAbort(void) {
+    TEST_ASSERT_NULL(TM_Reserve(APID_HK, TM_MAX_APP_DATA + 1));
+    TEST_ASSERT_NULL(TM_Reserve(APID_HK, 0));
+
+    uint8_t *p = TM_Reserve(APID_HK, TM_MAX_APP_DATA);
+    TEST_ASSERT_NOT_NULL(p);
+    TM_Abort(p);
+    TEST_ASSERT_NULL(sent_frame);
+
+    uint8_t foreign[32];
+    TEST_ASSERT_EQUAL_INT(-1, TM_Commit(&foreign[20]));
+}
+
+void test_TM_SecondCommitOrAbortIsRefused(void) {
+    fpool_stats_t stats;
+
+    // 1. Committed and held by the sink: neither a re-commit nor an abort touches it
+    uint8_t *p = TM_Reserve(APID_HK, 8);
+    TEST_ASSERT_EQUAL_INT(0, TM_Commit(p));
+    uint8_t *held = sent_frame;
+    TEST_ASSERT_EQUAL_INT(-1, TM_Commit(p));
+    TM_Abort(p);
+    TEST_ASSERT_EQUAL_PTR(held, sent_frame);
+    TM_ReleaseFrame(held);
+
+    // 2. Aborted twice, then committed: one free, nothing sent
+    sent_frame = NULL;
+    p = TM_Reserve(APID_HK, 8);
+    TM_Abort(p);
+    TM_Abort(p);
+    TEST_ASSERT_EQUAL_INT(-1, TM_Commit(p));
+    TEST_ASSERT_NULL(sent_frame);
+
+    // 3. Without a sink the commit frees the block; a second commit is refused
+    TM_SetDownlinkSink(NULL);
+    p = TM_Reserve(APID_HK, 8);
+    TEST_ASSERT_EQUAL_INT(0, TM_Commit(p));
+    TEST_ASSERT_EQUAL_INT(-1, TM_Commit(p));
+
+    FPOOL_GetStats(FPOOL_CLASS_SMALL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.in_use);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.bad_frees);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_TM_ReserveCommitBuildsWireFrameInPlace);
+    RUN_TEST(test_TM_SequenceCountPerApid);
+    RUN_TEST(test_TM_ReserveLimitsAndAbort);
+    RUN_TEST(test_TM_SecondCommitOrAbortIsRefused);
+    return UNITY_END();
+}
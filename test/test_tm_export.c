@@ -0,0 +1,200 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "tm_export.h"
+#include "ccsds_packet.h"
+#include "hk_schema.h"
+#include "param_db.h"
+#include "hk_delta.h"
+
+static char export_dir[64];
+
+void setUp(void) {
+    snprintf(export_dir, sizeof(export_dir), "/tmp/tmx_test_%d", (int)getpid());
+    TEST_ASSERT_EQUAL_INT(0, TMX_Open(export_dir));
+}
+
+void tearDown(void) {
+    TMX_Close();
+    char cmd[96];
+    snprintf(cmd, sizeof(cmd), "rm -rf %s", export_dir);
+    TEST_ASSERT_EQUAL_INT(0, system(cmd));
+}
+
+// Maps one column; returns the data array and its row count
+static const uint8_t *map_column(uint16_t apid, const char *name, size_t *rows, size_t *map_len) {
+    char path[128];
+    struct stat sb;
+    snprintf(path, sizeof(path), "%s/apid_%03X/%s.col", export_dir, apid, name);
+    int fd = open(path, O_RDONLY);
+    TEST_ASSERT_TRUE(fd >= 0);
+    fstat(fd, &sb);
+    const uint8_t *map = mmap(NULL, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    TEST_ASSERT_TRUE(map != MAP_FAILED);
+
+    const tmx_column_header_t *hdr = (const tmx_column_header_t *)map;
+    TEST_ASSERT_EQUAL_MEMORY(TMX_MAGIC, hdr->magic, 4);
+    TEST_ASSERT_EQUAL_STRING(name, hdr->name);
+    *rows = ((size_t)sb.st_size - TMX_HEADER_SIZE) / hdr->elem_size;
+    *map_len = (size_t)sb.st_size;
+    return map;
+}
+
+void test_TMX_SplitsApidsIntoColumns(void) {
+    uint8_t pkt[CCSDS_HEADERS_SIZE + 8];
+    const uint8_t data[3] = {1, 2, 3};
+
+    for (uint16_t i = 0; i < 100; i++) {
+        CCSDS_BuildHeaders(pkt, (i & 1) ? APID_EPS : APID_ADCS, (uint16_t)(0xC000 | i), sizeof(data), 1000u + i);
+        memcpy(&pkt[CCSDS_HEADERS_SIZE], data, sizeof(data));
+        TEST_ASSERT_EQUAL_INT(0, TMX_Append(pkt, CCSDS_HEADERS_SIZE + sizeof(data)));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, TMX_Append(pkt, 4));   // Truncated
+    TEST_ASSERT_EQUAL_INT(0, TMX_Flush());
+
+    tmx_stats_t stats;
+    TMX_GetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT64(100, stats.packets);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.rejected);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.streams);
+
+    size_t rows, len;
+    const uint8_t *map = map_column(APID_EPS, "met", &rows, &len);
+    const uint64_t *met = (const uint64_t *)(map + TMX_HEADER_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(50, rows);
+    TEST_ASSERT_EQUAL_UINT64(1001, met[0]);
+    TEST_ASSERT_EQUAL_UINT64(1099, met[49]);
+    munmap((void *)map, len);
+
+    map = map_column(APID_ADCS, "payload", &rows, &len);
+    TEST_ASSERT_EQUAL_UINT32(150, rows);
+    munmap((void *)map, len);
+}
+
+void test_TMX_HousekeepingFieldColumns(void) {
+    uint8_t pkt[CCSDS_HEADERS_SIZE + HK_PACKED_BYTES];
+
+    for (int i = 0; i < 10; i++) {
+        PARAM_Set(PARAM_ALTITUDE, 500000 + i);
+        PARAM_Set(PARAM_TARGET_TEMP, -i);
+        CCSDS_BuildHeaders(pkt, APID_HK, (uint16_t)(0xC000 | i), HK_PACKED_BYTES, (uint64_t)i);
+        HK_Pack(&pkt[CCSDS_HEADERS_SIZE]);
+        TEST_ASSERT_EQUAL_INT(0, TMX_Append(pkt, sizeof(pkt)));
+    }
+    TEST_ASSERT_EQUAL_INT(0, TMX_Flush());
+
+    size_t rows, len;
+    const uint8_t *map = map_column(APID_HK, "ALTITUDE", &rows, &len);
+    const int32_t *alt = (const int32_t *)(map + TMX_HEADER_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(10, rows);
+    TEST_ASSERT_EQUAL_INT32(500000, alt[0]);
+    TEST_ASSERT_EQUAL_INT32(500009, alt[9]);
+    munmap((void *)map, len);
+
+    map = map_column(APID_HK, "TARGET_TEMP", &rows, &len);
+    TEST_ASSERT_EQUAL_INT32(-9, ((const int32_t *)(map + TMX_HEADER_SIZE))[9]);
+    munmap((void *)map, len);
+}
+
+static void append_hk(uint16_t apid, uint16_t seq, const uint8_t *app, uint16_t app_len) {
+    uint8_t pkt[CCSDS_HEADERS_SIZE + HK_DELTA_MAX_BYTES];
+    CCSDS_BuildHeaders(pkt, apid, (uint16_t)(0xC000 | seq), app_len, seq);
+    memcpy(&pkt[CCSDS_HEADERS_SIZE], app, app_len);
+    TEST_ASSERT_EQUAL_INT(0, TMX_Append(pkt, (uint16_t)(CCSDS_HEADERS_SIZE + app_len)));
+}
+
+void test_TMX_MixedFullAndDeltaHousekeeping(void) {
+    hk_delta_encoder_t enc;
+    uint8_t full[HK_PACKED_BYTES];
+    uint8_t delta[HK_DELTA_MAX_BYTES];
+    uint32_t raw[HK_NUM_FIELDS];
+    int exact = 0;
+
+    PARAM_Set(PARAM_TARGET_TEMP, 15);
+    PARAM_Set(PARAM_ALTITUDE, 500000);
+    HK_DeltaEncoderInit(&enc, 8);
+
+    // Each cycle sends a full frame and a delta; altitude jumps by more than
+    // a small delta, so only the altitude field is FULL in each delta
+    for (uint16_t i = 0; i < 6; i++) {
+        PARAM_Set(PARAM_ALTITUDE, 500000 + 1000 * i);
+        HK_Pack(full);
+        append_hk(APID_HK, i, full, HK_PACKED_BYTES);
+
+        HK_SampleRaw(raw);
+        uint16_t len = HK_DeltaEncode(&enc, raw, delta);
+        exact += (len == HK_PACKED_BYTES);
+        append_hk(APID_HK_DELTA, i, delta, len);
+    }
+    TEST_ASSERT_EQUAL_INT(5, exact);   // Every delta after the keyframe
+    TEST_ASSERT_EQUAL_INT(0, TMX_Flush());
+
+    // Both streams decode to the same engineering values
+    uint16_t apids[2] = {APID_HK, APID_HK_DELTA};
+    for (int a = 0; a < 2; a++) {
+        size_t rows, len;
+        const uint8_t *map = map_column(apids[a], "ALTITUDE", &rows, &len);
+        const int32_t *alt = (const int32_t *)(map + TMX_HEADER_SIZE);
+        TEST_ASSERT_EQUAL_UINT32(6, rows);
+        for (int i = 0; i < 6; i++) TEST_ASSERT_EQUAL_INT32(500000 + 1000 * i, alt[i]);
+        munmap((void *)map, len);
+
+        map = map_column(apids[a], "TARGET_TEMP", &rows, &len);
+        TEST_ASSERT_EQUAL_INT32(15, ((const int32_t *)(map + TMX_HEADER_SIZE))[5]);
+        munmap((void *)map, len);
+    }
+}
+
+void test_TMX_UndecodableHousekeepingRowsAreFlagged(void) {
+    hk_delta_encoder_t enc;
+    uint8_t full[HK_PACKED_BYTES];
+    uint8_t delta[HK_DELTA_MAX_BYTES];
+    uint32_t raw[HK_NUM_FIELDS];
+    size_t rows, len;
+
+    // 1. A delta whose keyframe never arrived, then a short HK frame
+    PARAM_Set(PARAM_TARGET_TEMP, 0);
+    HK_DeltaEncoderInit(&enc, 8);
+    HK_SampleRaw(raw);
+    HK_DeltaEncode(&enc, raw, delta);   // Keyframe, lost
+    HK_SampleRaw(raw);
+    append_hk(APID_HK_DELTA, 1, delta, HK_DeltaEncode(&enc, raw, delta));
+    HK_Pack(full);
+    append_hk(APID_HK, 0, full, HK_PACKED_BYTES - 1);
+
+    // 2. A real 0 C reading
+    append_hk(APID_HK, 1, full, HK_PACKED_BYTES);
+    TEST_ASSERT_EQUAL_INT(0, TMX_Flush());
+
+    const uint8_t *map = map_column(APID_HK_DELTA, "hk_valid", &rows, &len);
+    TEST_ASSERT_EQUAL_UINT32(1, rows);
+    TEST_ASSERT_EQUAL_UINT8(0, map[TMX_HEADER_SIZE]);
+    munmap((void *)map, len);
+
+    map = map_column(APID_HK, "hk_valid", &rows, &len);
+    TEST_ASSERT_EQUAL_UINT32(2, rows);
+    TEST_ASSERT_EQUAL_UINT8(0, map[TMX_HEADER_SIZE]);
+    TEST_ASSERT_EQUAL_UINT8(1, map[TMX_HEADER_SIZE + 1]);
+    munmap((void *)map, len);
+
+    // Both HK rows read 0 in the field; only hk_valid tells them apart
+    map = map_column(APID_HK, "TARGET_TEMP", &rows, &len);
+    TEST_ASSERT_EQUAL_INT32(0, ((const int32_t *)(map + TMX_HEADER_SIZE))[0]);
+    TEST_ASSERT_EQUAL_INT32(0, ((const int32_t *)(map + TMX_HEADER_SIZE))[1]);
+    munmap((void *)map, len);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_TMX_SplitsApidsIntoColumns);
+    RUN_TEST(test_TMX_HousekeepingFieldColumns);
+    RUN_TEST(test_TMX_MixedFullAndDeltaHousekeeping);
+    RUN_TEST(test_TMX_UndecodableHousekeepingRowsAreFlagged);
+    return UNITY_END();
+}
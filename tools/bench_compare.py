@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+"""Compare two bench_comms JSON runs and flag regressions.
+
+    tools/bench_compare.py baseline.json current.json [--threshold 10]
+
+Benchmarks are matched by (name, cache). A benchmark regresses when its
+ns_per_op grew by more than the threshold (percent). Exits 1 if any did,
+so CI can gate on it.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        return {(r["name"], r["cache"]): r for r in json.load(f)["results"]}
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("baseline")
+    ap.add_argument("current")
+    ap.add_argument("--threshold", type=float, default=10.0,
+                    help="allowed slowdown in percent (default 10)")
+    args = ap.parse_args()
+
+    base = load(args.baseline)
+    cur = load(args.current)
+    regressions = 0
+
+    print(f"{'benchmark':32} {'cache':5} {'base ns/op':>12} {'now ns/op':>12} {'change':>8}")
+    for key in sorted(base.keys() | cur.keys()):
+        name, cache = key
+        if key not in cur or key not in base:
+            where = "baseline" if key in base else "current"
+            print(f"{name:32} {cache:5} {'':>12} {'':>12}   only in {where}")
+            continue
+        b = base[key]["ns_per_op"]
+        c = cur[key]["ns_per_op"]
+        change = (c - b) / b * 100.0 if b > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        elif change < -args.threshold:
+            flag = "  improved"
+        print(f"{name:32} {cache:5} {b:12.1f} {c:12.1f} {change:+7.1f}%{flag}")
+
+    if regressions:
+        print(f"\n{regressions} benchmark(s) slower than {args.threshold:.0f}% threshold")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())